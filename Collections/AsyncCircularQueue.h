@@ -0,0 +1,204 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_ASYNCCIRCULARQUEUE_H
+#define STATICCOLLECTIONS_ASYNCCIRCULARQUEUE_H
+
+#include <atomic>
+#include <coroutine>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "CircularQueue.h"
+
+/**
+ * CircularQueue adapter for C++20 coroutines: co_await queue.async_pop() suspends while the queue is empty and
+ * co_await queue.async_push(item) suspends while it is full.  The same single-producer/single-consumer rules as
+ * CircularQueue apply, so at most one coroutine waits on each side.
+ *
+ * There is no executor.  A waiting coroutine is resumed inline, on the caller's stack, by the next operation on the
+ * opposite side: the push that makes the queue non-empty resumes the consumer and the pop that makes room resumes
+ * the producer.  The resumed coroutine runs until it suspends again or finishes, and then the push or pop returns.
+ * Any push or pop resumes a waiter, whether it comes from a coroutine or from plain code such as a callback.
+ *
+ * With THREAD_SAFE false both sides must run on one thread (e.g. an event loop) and the waiter handles are plain
+ * pointers.  With THREAD_SAFE true the producer and consumer may run on different threads and the resumed coroutine
+ * continues on the thread of whoever resumed it; there is no hop back to the thread it suspended on.  Each handle
+ * is then an atomic the waiter publishes before a final check of the queue, and each push or pop pays a seq_cst fence
+ * to look for it, with the same pairing of fences as BlockingCircularQueue, so a wakeup can't be lost.
+ *
+ * A coroutine must not be left waiting when the queue is destroyed.
+ */
+template<typename T, size_t SIZE, bool THREAD_SAFE = false>
+class AsyncCircularQueue final {
+public:
+    typedef T value_type;
+    enum {CAPACITY = SIZE};
+
+    AsyncCircularQueue() = default;
+    AsyncCircularQueue(const std::initializer_list<T> &initializerList): mQueue(initializerList) {}
+
+    void clear() { mQueue.clear(); }
+    bool push(const T& item) requires std::copy_constructible<T> { return resumeConsumer(mQueue.push(item)); }
+    bool push(T&& item) { return resumeConsumer(mQueue.push(std::move(item))); }
+    template<typename... ARGS>
+    bool emplace(ARGS&&... args) { return resumeConsumer(mQueue.emplace(std::forward<ARGS>(args)...)); }
+    bool push(const T* items, size_t count) requires std::copy_constructible<T> {
+        return resumeConsumer(mQueue.push(items, count), count);
+    }
+    bool pop(T& item) { return resumeProducer(mQueue.pop(item)); }
+    std::optional<T> pop() { return resumeProducer(mQueue.pop()); }
+    bool pop(T* items, size_t count) { return resumeProducer(mQueue.pop(items, count), count); }
+    bool popElements(size_t count) { return resumeProducer(mQueue.popElements(count), count); }
+    bool peek(T& item) requires std::assignable_from<T&, const T&> { return mQueue.peek(item); }
+
+    [[nodiscard]] bool empty() const { return mQueue.empty(); }
+    [[nodiscard]] bool full() const { return mQueue.full(); }
+    [[nodiscard]] size_t size() const { return mQueue.size(); }
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+    size_t pushUpTo(const T* items, size_t count) { return resumeConsumer(mQueue.pushUpTo(items, count)); }
+    size_t popUpTo(T* items, size_t count) { return resumeProducer(mQueue.popUpTo(items, count)); }
+    template<typename FN>
+    size_t consume_all(FN &&fn) { return resumeProducer(mQueue.consume_all(std::forward<FN>(fn))); }
+
+    /**
+     * Awaitable returned by async_pop(); co_await yields the popped element.
+     */
+    class PopAwaiter {
+    public:
+        explicit PopAwaiter(AsyncCircularQueue &queue): mQueue(queue) {}
+
+        bool await_ready() {
+            mItem = mQueue.pop();
+            return mItem.has_value();
+        }
+        bool await_suspend(std::coroutine_handle<> consumer) {
+            return mQueue.suspend(mQueue.mConsumerWaiter, consumer, mQueue.consumerReady());
+        }
+        T await_resume() {
+            if(!mItem) {
+                // Only resumed once the queue is non-empty, so this fails only if another consumer got in first.
+                mItem = mQueue.pop();
+                if(!mItem) {
+                    throw std::logic_error("async_pop resumed on an empty queue.");
+                }
+            }
+            return std::move(*mItem);
+        }
+
+    private:
+        AsyncCircularQueue &mQueue;
+        std::optional<T> mItem;
+    };
+
+    /**
+     * Awaitable returned by async_push(); co_await completes once the element is in the queue.
+     */
+    class PushAwaiter {
+    public:
+        PushAwaiter(AsyncCircularQueue &queue, T &&item): mQueue(queue), mItem(std::move(item)) {}
+
+        bool await_ready() {
+            mPushed = mQueue.push(std::move(mItem));
+            return mPushed;
+        }
+        bool await_suspend(std::coroutine_handle<> producer) {
+            return mQueue.suspend(mQueue.mProducerWaiter, producer, mQueue.producerReady());
+        }
+        void await_resume() {
+            // Only resumed once the queue has room, so this fails only if another producer got in first.
+            if(!mPushed && !mQueue.push(std::move(mItem))) {
+                throw std::logic_error("async_push resumed on a full queue.");
+            }
+        }
+
+    private:
+        AsyncCircularQueue &mQueue;
+        T mItem;
+        bool mPushed{false};
+    };
+
+    /**
+     * Consumer only.  co_await async_pop() gets the front element, suspending while the queue is empty.
+     */
+    [[nodiscard]] PopAwaiter async_pop() { return PopAwaiter(*this); }
+
+    /**
+     * Producer only.  co_await async_push(item) pushes item, suspending while the queue is full.
+     */
+    [[nodiscard]] PushAwaiter async_push(T item) { return PushAwaiter(*this, std::move(item)); }
+
+private:
+    using WaiterSlot = std::conditional_t<THREAD_SAFE, std::atomic<void *>, void *>;
+
+    // Parks waiter in slot.  ready() re-checks the queue after the handle is published; if the other side got in
+    // first and nobody has claimed the handle yet, the waiter takes it back and continues without suspending.  Only
+    // queue members are touched once the handle is published, since the awaiter may already have been resumed.
+    template<typename READY>
+    bool suspend(WaiterSlot &slot, std::coroutine_handle<> waiter, READY ready) {
+        if constexpr(THREAD_SAFE) {
+            slot.store(waiter.address(), std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(ready()) {
+                return slot.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+            }
+        } else {
+            slot = waiter.address();
+        }
+        return true;
+    }
+
+    // What each waiter is waiting for: an element for the consumer, room for the producer.
+    auto consumerReady() const { return [this]() { return !empty(); }; }
+    auto producerReady() const { return [this]() { return !full(); }; }
+
+    // Resumes the coroutine parked in slot, if any, on this thread.  A waiter whose ready() doesn't hold stays parked
+    // rather than being resumed into an await_resume() that has nothing to do.
+    template<typename READY>
+    static void resume(WaiterSlot &slot, READY ready) {
+        void *waiter;
+        if constexpr(THREAD_SAFE) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(slot.load(std::memory_order_relaxed) == nullptr || !ready()) {
+                return;
+            }
+            waiter = slot.exchange(nullptr, std::memory_order_acq_rel);
+        } else {
+            if(slot == nullptr || !ready()) {
+                return;
+            }
+            waiter = std::exchange(slot, nullptr);
+        }
+        if(waiter) {
+            std::coroutine_handle<>::from_address(waiter).resume();
+        }
+    }
+
+    // Called by the producer after publishing.  count is how many elements a bulk push asked for: a successful push
+    // of none publishes nothing, so it resumes nobody.
+    template<typename RESULT>
+    RESULT resumeConsumer(RESULT published, size_t count = 1) {
+        if(published && count > 0) {
+            resume(mConsumerWaiter, consumerReady());
+        }
+        return published;
+    }
+
+    // Called by the consumer after releasing slots; count as for resumeConsumer().
+    template<typename RESULT>
+    RESULT resumeProducer(RESULT released, size_t count = 1) {
+        if(released && count > 0) {
+            resume(mProducerWaiter, producerReady());
+        }
+        return released;
+    }
+
+    CircularQueue<T, SIZE> mQueue;
+    alignas(CACHE_LINE_SIZE) WaiterSlot mConsumerWaiter{nullptr};
+    alignas(CACHE_LINE_SIZE) WaiterSlot mProducerWaiter{nullptr};
+};
+
+#endif //STATICCOLLECTIONS_ASYNCCIRCULARQUEUE_H
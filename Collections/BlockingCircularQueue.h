@@ -0,0 +1,183 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_BLOCKINGCIRCULARQUEUE_H
+#define STATICCOLLECTIONS_BLOCKINGCIRCULARQUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "CircularQueue.h"
+
+/**
+ * CircularQueue adapter that adds blocking push_wait()/pop_wait() and timed push_wait_for()/pop_wait_for().  The
+ * same single-producer/single-consumer rules as CircularQueue apply.
+ *
+ * A waiter spins briefly and then parks on the std::atomic::wait of the index the other side publishes (mTail for
+ * the consumer, mHead for the producer).  Each side raises a flag before parking, so a push or pop only pays for
+ * notify_one() when the opposite side is actually parked.  Publishing side: store index, fence, read flag.  Waiting
+ * side: store flag, fence, re-read index.  The two seq_cst fences guarantee at least one of them sees the other, so
+ * a wakeup can't be lost.
+ *
+ * std::atomic::wait has no timed form, so the _for variants back off with short sleeps instead of parking.
+ */
+template<typename T, size_t SIZE>
+class BlockingCircularQueue final {
+public:
+    typedef T value_type;
+    enum {CAPACITY = SIZE};
+
+    BlockingCircularQueue() = default;
+    BlockingCircularQueue(const std::initializer_list<T> &initializerList): mQueue(initializerList) {}
+
+    void clear() { mQueue.clear(); }
+    bool push(const T& item) requires std::copy_constructible<T> { return notifyConsumer(mQueue.push(item)); }
+    bool push(T&& item) { return notifyConsumer(mQueue.push(std::move(item))); }
+    template<typename... ARGS>
+    bool emplace(ARGS&&... args) { return notifyConsumer(mQueue.emplace(std::forward<ARGS>(args)...)); }
+    bool push(const T* items, size_t count) requires std::copy_constructible<T> {
+        return notifyConsumer(mQueue.push(items, count));
+    }
+    bool pop(T& item) { return notifyProducer(mQueue.pop(item)); }
+    std::optional<T> pop() { return notifyProducer(mQueue.pop()); }
+    bool pop(T* items, size_t count) { return notifyProducer(mQueue.pop(items, count)); }
+    bool popElements(size_t count) { return notifyProducer(mQueue.popElements(count)); }
+    bool peek(T& item) requires std::assignable_from<T&, const T&> { return mQueue.peek(item); }
+
+    [[nodiscard]] bool empty() const { return mQueue.empty(); }
+    [[nodiscard]] bool full() const { return mQueue.full(); }
+    [[nodiscard]] size_t size() const { return mQueue.size(); }
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+    size_t pushUpTo(const T* items, size_t count) { return notifyConsumer(mQueue.pushUpTo(items, count)); }
+    size_t popUpTo(T* items, size_t count) { return notifyProducer(mQueue.popUpTo(items, count)); }
+    std::span<T const> getBlock() const { return mQueue.getBlock(); }
+    template<typename FN>
+    size_t consume(FN &&fn, size_t maxCount) { return notifyProducer(mQueue.consume(std::forward<FN>(fn), maxCount)); }
+    template<typename FN>
+    size_t consume_all(FN &&fn) { return notifyProducer(mQueue.consume_all(std::forward<FN>(fn))); }
+    std::span<T> reserveBlock(size_t maxCount = SIZE) requires std::is_trivially_copyable_v<T> {
+        return mQueue.reserveBlock(maxCount);
+    }
+    bool commit(size_t count) requires std::is_trivially_copyable_v<T> { return notifyConsumer(mQueue.commit(count)); }
+
+    /**
+     * Pushes item, blocking while the queue is full.
+     */
+    void push_wait(const T& item) {
+        while(!spinUntil([&]() { return push(item); })) {
+            park(mProducerWaiting, mQueue.mHead, mQueue.mTail.load(std::memory_order_relaxed) - SIZE);
+        }
+    }
+
+    /**
+     * Pops into item, blocking while the queue is empty.
+     */
+    void pop_wait(T& item) {
+        while(!spinUntil([&]() { return pop(item); })) {
+            park(mConsumerWaiting, mQueue.mTail, mQueue.mHead.load(std::memory_order_relaxed));
+        }
+    }
+
+    /**
+     * Pushes item, waiting at most timeout for room in the queue.
+     *
+     * @return false if the queue was still full when the timeout expired.
+     */
+    template<typename REP, typename PERIOD>
+    bool push_wait_for(const T& item, const std::chrono::duration<REP, PERIOD> &timeout) {
+        return backoffUntil(std::chrono::steady_clock::now() + timeout, [&]() { return push(item); });
+    }
+
+    /**
+     * Pops into item, waiting at most timeout for an element.
+     *
+     * @return false if the queue was still empty when the timeout expired.
+     */
+    template<typename REP, typename PERIOD>
+    bool pop_wait_for(T& item, const std::chrono::duration<REP, PERIOD> &timeout) {
+        return backoffUntil(std::chrono::steady_clock::now() + timeout, [&]() { return pop(item); });
+    }
+
+private:
+    static constexpr int SPIN_COUNT = 64;
+
+    // Called by the producer after publishing; wakes the consumer only if it is parked.
+    template<typename RESULT>
+    RESULT notifyConsumer(RESULT published) {
+        if(published) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(mConsumerWaiting.load(std::memory_order_relaxed)) {
+                mQueue.mTail.notify_one();
+            }
+        }
+        return published;
+    }
+
+    // Called by the consumer after releasing slots; wakes the producer only if it is parked.
+    template<typename RESULT>
+    RESULT notifyProducer(RESULT released) {
+        if(released) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(mProducerWaiting.load(std::memory_order_relaxed)) {
+                mQueue.mHead.notify_one();
+            }
+        }
+        return released;
+    }
+
+    // Blocks until index no longer holds blockedValue, the value that makes the queue look full/empty to the caller.
+    static void park(std::atomic_bool &waiting, std::atomic_uint64_t &index, std::uint64_t blockedValue) {
+        waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(index.load(std::memory_order_relaxed) == blockedValue) {
+            index.wait(blockedValue, std::memory_order_acquire);
+        }
+        waiting.store(false, std::memory_order_relaxed);
+    }
+
+    template<typename OPERATION>
+    static bool spinUntil(OPERATION operation) {
+        for(int i = 0; i < SPIN_COUNT; i++) {
+            if(operation()) {
+                return true;
+            }
+            cpuRelax();
+        }
+        return false;
+    }
+
+    template<typename OPERATION>
+    static bool backoffUntil(std::chrono::steady_clock::time_point deadline, OPERATION operation) {
+        if(spinUntil(operation)) {
+            return true;
+        }
+        std::chrono::microseconds delay{1};
+        for(;;) {
+            const auto now = std::chrono::steady_clock::now();
+            if(now >= deadline) {
+                return operation();
+            }
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(delay, deadline - now));
+            if(operation()) {
+                return true;
+            }
+            delay = std::min(delay * 2, std::chrono::microseconds{1000});
+        }
+    }
+
+    static void cpuRelax() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    CircularQueue<T, SIZE> mQueue;
+    alignas(CACHE_LINE_SIZE) std::atomic_bool mConsumerWaiting{false};
+    alignas(CACHE_LINE_SIZE) std::atomic_bool mProducerWaiting{false};
+};
+
+#endif //STATICCOLLECTIONS_BLOCKINGCIRCULARQUEUE_H
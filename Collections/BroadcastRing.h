@@ -0,0 +1,237 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_BROADCASTRING_H
+#define STATICCOLLECTIONS_BROADCASTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include "CacheLine.h"
+
+/**
+ * Single-producer ring whose elements are delivered to every registered consumer (Disruptor style), e.g. one stream
+ * feeding logging, metrics and the main pipeline without a queue and a copy per reader.  The producer publishes a
+ * free-running sequence (mTail) and each consumer owns a cursor, on its own cache line, that only it advances.  A slot
+ * is reused once every consumer has moved past it, so the producer is gated by the slowest consumer; it keeps a
+ * cached minimum of the cursors and only rescans them when the cached value says the ring is full.
+ *
+ * Consumers read elements in place: getBlock() gives a span over the longest contiguous run of unread elements and
+ * popElements() releases them, so a consumer can process a whole batch with no copies.  With no consumer registered
+ * the producer never blocks and elements are simply dropped.
+ *
+ * MAX_CONSUMERS bounds the number of cursors.  Consumers are registered before the producer and consumers start;
+ * unregisterConsumer() may be called at any time, e.g. to stop a stalled consumer from holding back the producer.
+ */
+template<typename T, size_t SIZE, size_t MAX_CONSUMERS = 8>
+class BroadcastRing final {
+public:
+    enum {CAPACITY = SIZE};
+
+    BroadcastRing() = default;
+    BroadcastRing(const BroadcastRing &) = delete;
+    BroadcastRing &operator=(const BroadcastRing &) = delete;
+
+    /**
+     * Not thread safe; neither producer nor consumers may be active.  Adds a consumer that will see every element
+     * pushed from now on.
+     *
+     * @return the consumer's id, passed to the consumer functions.
+     */
+    size_t registerConsumer() {
+        for(size_t id = 0; id < MAX_CONSUMERS; id++) {
+            if(mCursors[id].mPosition.load(std::memory_order_relaxed) == INACTIVE) {
+                const auto tail = mTail.load(std::memory_order_relaxed);
+                mCursors[id].mPosition.store(tail, std::memory_order_relaxed);
+                mCursors[id].mCachedTail = tail;
+                mCachedMin = std::min(mCachedMin, tail);
+                return id;
+            }
+        }
+        throw std::runtime_error("number of consumers exceeds MAX_CONSUMERS.");
+    }
+
+    /**
+     * Removes a consumer; the producer no longer waits for it.  May be called from any thread, but the consumer
+     * itself must have stopped.
+     */
+    void unregisterConsumer(size_t consumer) {
+        mCursors[consumer].mPosition.store(INACTIVE, std::memory_order_release);
+    }
+
+    // Producer functions
+
+    bool push(const T& item) { return emplace(item); }
+    bool push(T&& item) { return emplace(std::move(item)); }
+
+    /**
+     * Pushes all count items or, if the slowest consumer hasn't left room for them, none.
+     */
+    bool push(const T* items, size_t count) {
+        if(!items) {
+            return false;
+        }
+        const auto tail = mTail.load(std::memory_order_relaxed);
+        if(freeSpace(tail, count) < count) {
+            return false;
+        }
+        copyIn(tail, items, count);
+        mTail.store(tail + count, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pushes as many of the items as currently fit.
+     *
+     * @return the number of items pushed.
+     */
+    size_t pushUpTo(const T* items, size_t count) {
+        if(!items) {
+            return 0;
+        }
+        const auto tail = mTail.load(std::memory_order_relaxed);
+        count = std::min(count, freeSpace(tail, count));
+        copyIn(tail, items, count);
+        mTail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer functions, each called only by the thread owning that consumer id
+
+    /**
+     * The longest contiguous run of elements this consumer hasn't released yet.  The elements stay valid, and
+     * unchanged, until released with popElements().
+     */
+    std::span<T const> getBlock(size_t consumer) {
+        Cursor &cursor = mCursors[consumer];
+        const auto position = cursor.mPosition.load(std::memory_order_relaxed);
+        cursor.mCachedTail = mTail.load(std::memory_order_acquire);
+        const size_t first = index(position);
+        return {&mSlots[first], std::min<size_t>(cursor.mCachedTail - position, SIZE - first)};
+    }
+
+    /**
+     * Releases up to count elements of this consumer, e.g. after processing a getBlock().
+     */
+    bool popElements(size_t consumer, size_t count) {
+        Cursor &cursor = mCursors[consumer];
+        const auto position = cursor.mPosition.load(std::memory_order_relaxed);
+        count = std::min<size_t>(count, mTail.load(std::memory_order_acquire) - position);
+        cursor.mPosition.store(position + count, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(size_t consumer, T& item) {
+        Cursor &cursor = mCursors[consumer];
+        const auto position = cursor.mPosition.load(std::memory_order_relaxed);
+        if(position == cursor.mCachedTail) {
+            cursor.mCachedTail = mTail.load(std::memory_order_acquire);
+            if(position == cursor.mCachedTail) {
+                return false;   // nothing new for this consumer
+            }
+        }
+        item = mSlots[index(position)];
+        cursor.mPosition.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Invokes fn(const T&) on up to maxCount of this consumer's elements, in place and in order, and then releases
+     * them with a single cursor store.
+     *
+     * @return the number of elements consumed.
+     */
+    template<typename FN>
+    size_t consume(size_t consumer, FN &&fn, size_t maxCount = SIZE) {
+        Cursor &cursor = mCursors[consumer];
+        const auto position = cursor.mPosition.load(std::memory_order_relaxed);
+        cursor.mCachedTail = mTail.load(std::memory_order_acquire);
+        const size_t count = std::min<size_t>(maxCount, cursor.mCachedTail - position);
+        const size_t first = index(position);
+        const size_t firstRun = std::min(count, SIZE - first);
+        for(size_t i = 0; i < firstRun; i++) {
+            fn(std::as_const(mSlots[first + i]));
+        }
+        for(size_t i = 0; i < count - firstRun; i++) {
+            fn(std::as_const(mSlots[i]));
+        }
+        cursor.mPosition.store(position + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * Number of elements this consumer hasn't released yet; 0 for a consumer that isn't registered.
+     */
+    [[nodiscard]] size_t size(size_t consumer) const {
+        const auto position = mCursors[consumer].mPosition.load(std::memory_order_relaxed);
+        if(position == INACTIVE) {
+            return 0;
+        }
+        return mTail.load(std::memory_order_acquire) - position;
+    }
+
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+private:
+    static constexpr std::uint64_t INACTIVE = std::numeric_limits<std::uint64_t>::max();
+
+    template<typename U>
+    bool emplace(U &&item) {
+        const auto tail = mTail.load(std::memory_order_relaxed);
+        if(freeSpace(tail, 1) == 0) {
+            return false;   // the slowest consumer is SIZE elements behind
+        }
+        mSlots[index(tail)] = std::forward<U>(item);
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only.  Free slots ahead of tail, rescanning the cursors only if the cached minimum says there isn't
+    // room for the wanted number of elements.
+    size_t freeSpace(std::uint64_t tail, size_t wanted) {
+        if(SIZE - (tail - mCachedMin) < wanted) {
+            std::uint64_t slowest = tail;
+            for(const auto &cursor: mCursors) {
+                slowest = std::min(slowest, cursor.mPosition.load(std::memory_order_acquire));
+            }
+            mCachedMin = slowest;
+        }
+        return SIZE - (tail - mCachedMin);
+    }
+
+    void copyIn(std::uint64_t tail, const T* items, size_t count) {
+        const size_t first = index(tail);
+        const size_t firstRun = std::min(count, SIZE - first);
+        std::copy_n(items, firstRun, &mSlots[first]);
+        std::copy_n(items + firstRun, count - firstRun, &mSlots[0]);
+    }
+
+    [[nodiscard]] static constexpr size_t index(std::uint64_t counter) {
+        if constexpr((SIZE & (SIZE - 1)) == 0) {
+            return counter & (SIZE - 1);
+        } else {
+            return counter % SIZE;
+        }
+    }
+
+    struct alignas(CACHE_LINE_SIZE) Cursor {
+        std::atomic_uint64_t mPosition{INACTIVE};   // count of elements this consumer has released
+        std::uint64_t       mCachedTail{0};         // this consumer's last observed mTail
+    };
+
+    // Producer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mTail{0};   // count of elements ever pushed
+    std::uint64_t       mCachedMin{0};                         // producer's last observed slowest cursor
+
+    Cursor mCursors[MAX_CONSUMERS];
+
+    alignas(CACHE_LINE_SIZE) T mSlots[SIZE]{};
+};
+
+#endif //STATICCOLLECTIONS_BROADCASTRING_H
@@ -0,0 +1,32 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_CACHELINE_H
+#define STATICCOLLECTIONS_CACHELINE_H
+
+#include <cstddef>
+#include <new>
+
+/**
+ * Size in bytes used to keep independently written members (e.g. producer and consumer indices) on separate cache
+ * lines.  Defaults to std::hardware_destructive_interference_size when the standard library provides it, otherwise 64.
+ * Define STATICCOLLECTIONS_CACHE_LINE_SIZE to pin the value, e.g. when a layout is shared between binaries built with
+ * different tuning flags.
+ */
+#if defined(STATICCOLLECTIONS_CACHE_LINE_SIZE)
+inline constexpr std::size_t CACHE_LINE_SIZE = STATICCOLLECTIONS_CACHE_LINE_SIZE;
+#elif defined(__cpp_lib_hardware_interference_size)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+inline constexpr std::size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+#endif
+
+#endif //STATICCOLLECTIONS_CACHELINE_H
@@ -2,17 +2,46 @@
 #define STATICCOLLECTIONS_CIRCULARQUEUE_H
 
 #include <iostream>
+#include <concepts>
 #include <cstddef>
 #include <atomic>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
 #include <span>
+#include <type_traits>
+#include <utility>
+#include "CacheLine.h"
 #include "Queue.h"
+#include "QueueStatistics.h"
 
-template<typename T, size_t SIZE>
-class CircularQueue: public Queue<T> {
+/**
+ * Lock-free single-producer/single-consumer queue.  Exactly one thread may call the producer functions (push) and
+ * exactly one thread may call the consumer functions (pop, popElements, peek, getBlock).  Each index lives on its own
+ * cache line next to a private copy of the opposite index, so the shared atomic is only re-read when the queue looks
+ * full (producer) or empty (consumer).
+ *
+ * mTail and mHead are free-running 64 bit counters, so all SIZE slots are usable and size() is a single subtraction.
+ * A power of two SIZE maps a counter onto its slot with a mask; any other SIZE costs a modulo per access.
+ *
+ * The storage is left uninitialized: elements are constructed in place when pushed and destroyed when popped, so T
+ * needn't be default constructible, move-only types such as std::unique_ptr can be queued with push(T&&)/emplace()
+ * and pop(), and constructing even a very large queue costs nothing.  For a T that isn't copyable the QueueType
+ * functions that need a copy (push(const T&), push(const T*, size_t) and peek()) don't exist, so such a queue is not
+ * a QueueType.
+ *
+ * STATS is a statistics policy (see QueueStatistics.h), e.g. CircularQueue<Msg, 1024, QueueStatistics<16>> to find
+ * out how full the queue gets in production.  The default NoQueueStatistics records nothing and costs nothing.
+ */
+template<typename T, size_t SIZE, typename STATS = NoQueueStatistics>
+class CircularQueue final {
 public:
+    typedef T value_type;
     enum {CAPACITY = SIZE};
-    CircularQueue() : mTail(0), mHead(0){}
+    CircularQueue() = default;
     CircularQueue(const std::initializer_list<T> &initializerList) {
         if(initializerList.size() > SIZE) {
             throw std::runtime_error("number of initializer elements exceeds capacity.");
@@ -22,19 +51,60 @@ public:
             this->push(*elem);
         }
     }
-    virtual ~CircularQueue() = default;
+    ~CircularQueue() { clear(); }
 
-    void clear() override { mTail = 0; mHead = 0; }
-    bool push(const T& item) override;
-    bool push(const T* items, size_t count) override;
-    bool pop(T& item) override;
-    bool popElements(size_t count) override;
-    bool peek(T& item) override;
+    // Not thread safe; neither producer nor consumer may be active.
+    void clear() {
+        const auto head = mHead.load(std::memory_order_relaxed);
+        destroyElements(head, mTail.load(std::memory_order_relaxed) - head);
+        mTail.store(0, std::memory_order_relaxed);
+        mHead.store(0, std::memory_order_relaxed);
+        mCachedHead = 0;
+        mCachedTail = 0;
+    }
+    bool push(const T& item) requires std::copy_constructible<T> { return emplace(item); }
+    bool push(T&& item) { return emplace(std::move(item)); }
+    bool push(const T* items, size_t count) requires std::copy_constructible<T>;
+    bool pop(T& item);
+    bool pop(T* items, size_t count);
+    bool popElements(size_t count);
+    bool peek(T& item) requires std::assignable_from<T&, const T&>;
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] bool full() const;
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+    /**
+     * Constructs an element in place at the tail of the queue from args.
+     *
+     * @return false, without constructing anything, if the queue is full.
+     */
+    template<typename... ARGS>
+    bool emplace(ARGS&&... args);
+
+    /**
+     * Moves the front element out of the queue.
+     *
+     * @return the element, or std::nullopt if the queue is empty.
+     */
+    std::optional<T> pop();
+
+    /**
+     * Pushes as many of the items as currently fit.  The elements are copied in at most two contiguous runs (memcpy
+     * for trivially copyable types) and published with a single tail store.
+     *
+     * @return the number of items pushed.
+     */
+    size_t pushUpTo(const T* items, size_t count);
 
-    [[nodiscard]] bool empty() const override;
-    [[nodiscard]] bool full() const override;
-    [[nodiscard]] size_t size() const override;
-    [[nodiscard]] size_t capacity() const  override { return CAPACITY; }
+    /**
+     * Pops up to count elements into items, copying out in at most two contiguous runs and publishing the new head
+     * with a single store.
+     *
+     * @return the number of items popped.
+     */
+    size_t popUpTo(T* items, size_t count);
 
     /**
      * Gets the span that includes the longest contiguous bytes from the front of the queue.  This is useful because
@@ -55,118 +125,389 @@ public:
      * @return a span of the data in the first block.
      */
     std::span<T const> getBlock() const {
-        if(empty()) {
-            return {};
-        }
+        const auto head = mHead.load(std::memory_order_relaxed);
+        const auto tail = mTail.load(std::memory_order_acquire);
+        const size_t first = index(head);
+        const size_t count = std::min<size_t>(tail - head, SIZE - first);
+
+        return {slot(first), count};
+    }
+
+    /**
+     * Invokes fn(T&) on up to maxCount elements at the front of the queue, in order, directly on the queue storage
+     * and then destroys them and publishes the new head with a single store.  Only elements visible on entry are consumed; elements
+     * pushed while fn is running are left for the next call.  If fn throws, the elements it already processed are
+     * popped and the exception propagates.
+     *
+     * @return the number of elements consumed.
+     */
+    template<typename FN>
+    size_t consume(FN &&fn, size_t maxCount);
+
+    /**
+     * consume() without a limit: drains every element visible on entry.
+     */
+    template<typename FN>
+    size_t consume_all(FN &&fn) { return consume(std::forward<FN>(fn), SIZE); }
+
+    /**
+     * Producer side counterpart of getBlock().  Gets a writable span over the longest contiguous run of free slots
+     * at the tail of the queue, limited to maxCount elements, so data can be written straight into the queue storage
+     * (e.g. by read(2) or a DMA engine).  Nothing is visible to the consumer until commit() is called.  Like getBlock(),
+     * the free space may be split in two runs, so a producer that wants to fill the queue calls this twice:
+     *
+     * while(remaining) {
+     *      const auto block{queue.reserveBlock(remaining)};
+     *      if(block.empty()) {
+     *          break;  // full
+     *      }
+     *      const auto n = read(fd, block.data(), block.size());
+     *      queue.commit(n);
+     *      remaining -= n;
+     * }
+     *
+     * Only available for trivially copyable types, since the slots hold no constructed objects until written.
+     *
+     * @param maxCount - largest number of elements wanted.
+     * @return a span of free slots, empty if the queue is full.
+     */
+    std::span<T> reserveBlock(size_t maxCount = SIZE) requires std::is_trivially_copyable_v<T> {
+        const auto tail = mTail.load(std::memory_order_relaxed);
+        const size_t first = index(tail);
+        const size_t count = std::min({maxCount, freeSpace(tail, maxCount), SIZE - first});
 
-        const int tail = mTail.load();
-        const int head = mHead.load();
-        const std::uint16_t count = (head < tail)?
-                                    (tail - head):
-                                    ((CAPACITY+1) - head);
+        return {slot(first), count};
+    }
 
-        return {mArray + head, count};
+    /**
+     * Publishes the first count elements written into the span returned by reserveBlock() with a single tail store.
+     *
+     * @param count - number of elements written, no more than the size of the reserved span.
+     * @return false, without publishing anything, if count exceeds the free space in the queue.
+     */
+    bool commit(size_t count) requires std::is_trivially_copyable_v<T> {
+        const auto tail = mTail.load(std::memory_order_relaxed);
+        if(count > SIZE - (tail - mCachedHead)) {
+            return false;
+        }
+        recordPush(tail, count);
+        mTail.store(tail + count, std::memory_order_release);
+        return true;
     }
 
+    /**
+     * The statistics policy's counters, e.g. statistics().highWaterMark().  Only meaningful when STATS is not
+     * NoQueueStatistics.
+     */
+    const STATS &statistics() const { return mStats; }
+
 private:
-    [[nodiscard]] size_t increment(size_t idx) const;
+    // Parks on mHead/mTail with std::atomic::wait.
+    template<typename, size_t> friend class BlockingCircularQueue;
+
+    [[nodiscard]] size_t freeSpace(std::uint64_t tail, size_t wanted);
+    [[nodiscard]] size_t available(std::uint64_t head);
+    void copyIn(std::uint64_t tail, const T* items, size_t count);
+    void moveOut(std::uint64_t head, T* items, size_t count);
+    void destroyElements(std::uint64_t head, size_t count);
+
+    // Producer only.  Reads mHead for the occupancy only when statistics are enabled.
+    void recordPush(std::uint64_t tail, size_t count) {
+        if constexpr(STATS::ENABLED) {
+            mStats.pushed(count, tail - mHead.load(std::memory_order_relaxed), SIZE);
+        }
+    }
+
+    [[nodiscard]] T* slot(size_t idx) { return reinterpret_cast<T*>(mStorage) + idx; }
+    [[nodiscard]] const T* slot(size_t idx) const { return reinterpret_cast<const T*>(mStorage) + idx; }
+
+    static constexpr bool POWER_OF_TWO = (SIZE & (SIZE - 1)) == 0;
+
+    // Maps a free-running counter onto a slot in mStorage.
+    [[nodiscard]] static constexpr size_t index(std::uint64_t counter) {
+        if constexpr(POWER_OF_TWO) {
+            return counter & (SIZE - 1);
+        } else {
+            return counter % SIZE;
+        }
+    }
+
+    // Producer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mTail{0};   // count of elements ever pushed
+    std::uint64_t       mCachedHead{0};                        // producer's last observed mHead
+
+    // Consumer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mHead{0};   // count of elements ever popped
+    std::uint64_t       mCachedTail{0};                        // consumer's last observed mTail
+
+    alignas(CACHE_LINE_SIZE) alignas(T) std::byte mStorage[SIZE * sizeof(T)];
 
-    std::atomic_size_t  mTail;  // tail(input) index
-    T                   mArray[SIZE + 1]{};
-    std::atomic_size_t  mHead; // mHead(output) index
+    [[no_unique_address]] STATS mStats;
 };
 
-template<typename T, size_t Size>
-bool CircularQueue<T, Size>::push(const T& item) {
-    const auto current_tail = mTail.load();
-    const auto next_tail = increment(current_tail);
-    if(next_tail != mHead.load()) {
-        mArray[current_tail] = item;
-        mTail.store(next_tail);
-        return true;
+template<typename T, size_t Size, typename STATS>
+template<typename... ARGS>
+bool CircularQueue<T, Size, STATS>::emplace(ARGS&&... args) {
+    const auto current_tail = mTail.load(std::memory_order_relaxed);
+    if(current_tail - mCachedHead == Size) {
+        mCachedHead = mHead.load(std::memory_order_acquire);
+        if(current_tail - mCachedHead == Size) {
+            mStats.pushFull();
+            return false;  // full queue
+        }
     }
-    return false;  // full queue
+    new(slot(index(current_tail))) T(std::forward<ARGS>(args)...);
+    recordPush(current_tail, 1);
+    mTail.store(current_tail + 1, std::memory_order_release);
+    return true;
 }
 
-template<typename T, size_t SIZE>
-bool CircularQueue<T, SIZE>::push(const T *items, size_t count) {
+// All or nothing: either every item is pushed or the queue is left untouched.
+template<typename T, size_t SIZE, typename STATS>
+bool CircularQueue<T, SIZE, STATS>::push(const T *items, size_t count) requires std::copy_constructible<T> {
     if(!items) {
         return false;
     }
-    while(count--) {
-        if(!push(*items++)) {
-            return false;
-        }
+    const auto current_tail = mTail.load(std::memory_order_relaxed);
+    if(freeSpace(current_tail, count) < count) {
+        mStats.pushFull();
+        return false;
     }
+    copyIn(current_tail, items, count);
+    recordPush(current_tail, count);
+    mTail.store(current_tail + count, std::memory_order_release);
     return true;
 }
 
+template<typename T, size_t SIZE, typename STATS>
+size_t CircularQueue<T, SIZE, STATS>::pushUpTo(const T *items, size_t count) {
+    if(!items) {
+        return 0;
+    }
+    const auto current_tail = mTail.load(std::memory_order_relaxed);
+    const size_t pushed = std::min(count, freeSpace(current_tail, count));
+    if(pushed < count) {
+        mStats.pushFull();
+    }
+    count = pushed;
+    copyIn(current_tail, items, count);
+    recordPush(current_tail, count);
+    mTail.store(current_tail + count, std::memory_order_release);
+    return count;
+}
+
 // Pop by Consumer can only update the mHead
-template<typename T, size_t Size>
-bool CircularQueue<T, Size>::pop(T& item) {
-    const auto current_head = mHead.load();
-    if(current_head == mTail.load()) {
-        return false;   // empty queue
+template<typename T, size_t Size, typename STATS>
+bool CircularQueue<T, Size, STATS>::pop(T& item) {
+    const auto current_head = mHead.load(std::memory_order_relaxed);
+    if(current_head == mCachedTail) {
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        if(current_head == mCachedTail) {
+            mStats.popEmpty();
+            return false;   // empty queue
+        }
     }
 
-    item = mArray[current_head];
-    mHead.store(increment(current_head));
+    T *element = slot(index(current_head));
+    item = std::move(*element);
+    element->~T();
+    mStats.popped(1);
+    mHead.store(current_head + 1, std::memory_order_release);
     return true;
 }
 
 // Pop by Consumer can only update the mHead
-template<typename T, size_t Size>
-bool CircularQueue<T, Size>::popElements(size_t count) {
-    const uint16_t numToPop = std::min(count, size());
-    auto current_head = mHead.load();
-    current_head = (std::uint16_t) ((current_head + numToPop) % std::size(mArray));
-    mHead.store(current_head);
+template<typename T, size_t Size, typename STATS>
+std::optional<T> CircularQueue<T, Size, STATS>::pop() {
+    const auto current_head = mHead.load(std::memory_order_relaxed);
+    if(current_head == mCachedTail) {
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        if(current_head == mCachedTail) {
+            mStats.popEmpty();
+            return std::nullopt;   // empty queue
+        }
+    }
+
+    T *element = slot(index(current_head));
+    std::optional<T> item{std::move(*element)};
+    element->~T();
+    mStats.popped(1);
+    mHead.store(current_head + 1, std::memory_order_release);
+    return item;
+}
+
+// Pop by Consumer can only update the mHead.  All or nothing: either count elements are popped or none are.
+template<typename T, size_t SIZE, typename STATS>
+bool CircularQueue<T, SIZE, STATS>::pop(T *items, size_t count) {
+    if(!items) {
+        return false;
+    }
+    const auto current_head = mHead.load(std::memory_order_relaxed);
+    if(available(current_head) < count) {
+        mStats.popEmpty();
+        return false;
+    }
+    moveOut(current_head, items, count);
+    mStats.popped(count);
+    mHead.store(current_head + count, std::memory_order_release);
     return true;
 }
 
 // Pop by Consumer can only update the mHead
-template<typename T, size_t Size>
-bool CircularQueue<T, Size>::peek(T& item) {
-    const auto current_head = mHead.load();
-    if(current_head == mTail.load()) {
-        return false;   // empty queue
+template<typename T, size_t SIZE, typename STATS>
+size_t CircularQueue<T, SIZE, STATS>::popUpTo(T *items, size_t count) {
+    if(!items) {
+        return 0;
     }
+    const auto current_head = mHead.load(std::memory_order_relaxed);
+    const size_t popped = std::min(count, available(current_head));
+    if(popped < count) {
+        mStats.popEmpty();
+    }
+    count = popped;
+    moveOut(current_head, items, count);
+    mStats.popped(count);
+    mHead.store(current_head + count, std::memory_order_release);
+    return count;
+}
 
-    item = mArray[current_head];
+// Pop by Consumer can only update the mHead
+template<typename T, size_t SIZE, typename STATS>
+template<typename FN>
+size_t CircularQueue<T, SIZE, STATS>::consume(FN &&fn, size_t maxCount) {
+    const auto current_head = mHead.load(std::memory_order_relaxed);
+    const size_t count = std::min(maxCount, available(current_head));
+    const size_t first = index(current_head);
+    const size_t firstRun = std::min(count, SIZE - first);
+
+    size_t consumed = 0;
+    try {
+        for(; consumed < firstRun; consumed++) {
+            T *element = slot(first + consumed);
+            fn(*element);
+            element->~T();
+        }
+        for(; consumed < count; consumed++) {
+            T *element = slot(consumed - firstRun);
+            fn(*element);
+            element->~T();
+        }
+    } catch(...) {
+        mStats.popped(consumed);
+        mHead.store(current_head + consumed, std::memory_order_release);
+        throw;
+    }
+
+    mStats.popped(count);
+    mHead.store(current_head + count, std::memory_order_release);
+    return count;
+}
+
+// Pop by Consumer can only update the mHead
+template<typename T, size_t Size, typename STATS>
+bool CircularQueue<T, Size, STATS>::popElements(size_t count) {
+    const auto current_head = mHead.load(std::memory_order_relaxed);
+    count = std::min<size_t>(count, mTail.load(std::memory_order_acquire) - current_head);
+    destroyElements(current_head, count);
+    mStats.popped(count);
+    mHead.store(current_head + count, std::memory_order_release);
     return true;
 }
 
-template<typename T, size_t Size>
-size_t CircularQueue<T, Size>::size() const {
-    const int tail = mTail.load();
-    const int head = mHead.load();
-    if(tail >= head) {
-        return tail - head;
-    } else {
-        return (std::uint16_t) ((CAPACITY+1) - head + tail);
+// Pop by Consumer can only update the mHead
+template<typename T, size_t Size, typename STATS>
+bool CircularQueue<T, Size, STATS>::peek(T& item) requires std::assignable_from<T&, const T&> {
+    const auto current_head = mHead.load(std::memory_order_relaxed);
+    if(current_head == mCachedTail) {
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        if(current_head == mCachedTail) {
+            return false;   // empty queue
+        }
     }
+
+    item = *slot(index(current_head));
+    return true;
+}
+
+// Head is loaded first so that a concurrent push/pop can only make the difference look larger, never wrap it.
+template<typename T, size_t Size, typename STATS>
+size_t CircularQueue<T, Size, STATS>::size() const {
+    const auto head = mHead.load(std::memory_order_acquire);
+    const auto tail = mTail.load(std::memory_order_acquire);
+    return std::min<std::uint64_t>(tail - head, Size);
 }
 
 // snapshot with acceptance of that this comparison function is not atomic
 // (*) Used by clients or test, since pop() avoid double load overhead by not
 // using empty()
-template<typename T, size_t Size>
-bool CircularQueue<T, Size>::empty() const {
-    return (mHead.load() == mTail.load());
+template<typename T, size_t Size, typename STATS>
+bool CircularQueue<T, Size, STATS>::empty() const {
+    return size() == 0;
 }
 
 // snapshot with acceptance that this comparison is not atomic
 // (*) Used by clients or test, since push() avoid double load overhead by not
 // using full()
-template<typename T, size_t Size>
-bool CircularQueue<T, Size>::full() const {
-    const auto next_tail = increment(mTail.load());
-    return (next_tail == mHead.load());
+template<typename T, size_t Size, typename STATS>
+bool CircularQueue<T, Size, STATS>::full() const {
+    return size() == Size;
 }
 
-template<typename T, size_t Size>
-size_t CircularQueue<T, Size>::increment(size_t idx) const {
-    return (idx + 1) % std::size(mArray);
+// Producer only.  Free slots ahead of tail, reloading mHead only if the cached copy says there isn't room for
+// the wanted number of elements.
+template<typename T, size_t SIZE, typename STATS>
+size_t CircularQueue<T, SIZE, STATS>::freeSpace(std::uint64_t tail, size_t wanted) {
+    if(SIZE - (tail - mCachedHead) < wanted) {
+        mCachedHead = mHead.load(std::memory_order_acquire);
+    }
+    return SIZE - (tail - mCachedHead);
+}
+
+// Consumer only.  Elements readable from head; the cached tail is refreshed on every call because a bulk reader
+// wants everything that is visible.
+template<typename T, size_t SIZE, typename STATS>
+size_t CircularQueue<T, SIZE, STATS>::available(std::uint64_t head) {
+    mCachedTail = mTail.load(std::memory_order_acquire);
+    return mCachedTail - head;
+}
+
+// Copy constructs count items into the free slots starting at tail, in at most two runs.
+template<typename T, size_t SIZE, typename STATS>
+void CircularQueue<T, SIZE, STATS>::copyIn(std::uint64_t tail, const T *items, size_t count) {
+    const size_t first = index(tail);
+    const size_t firstRun = std::min(count, SIZE - first);
+    if constexpr(std::is_trivially_copyable_v<T>) {
+        std::memcpy(slot(first), items, firstRun * sizeof(T));
+        std::memcpy(slot(0), items + firstRun, (count - firstRun) * sizeof(T));
+    } else {
+        std::uninitialized_copy_n(items, firstRun, slot(first));
+        std::uninitialized_copy_n(items + firstRun, count - firstRun, slot(0));
+    }
+}
+
+// Moves count elements starting at head out into items, in at most two runs, and destroys them in the queue.
+template<typename T, size_t SIZE, typename STATS>
+void CircularQueue<T, SIZE, STATS>::moveOut(std::uint64_t head, T *items, size_t count) {
+    const size_t first = index(head);
+    const size_t firstRun = std::min(count, SIZE - first);
+    if constexpr(std::is_trivially_copyable_v<T>) {
+        std::memcpy(items, slot(first), firstRun * sizeof(T));
+        std::memcpy(items + firstRun, slot(0), (count - firstRun) * sizeof(T));
+    } else {
+        std::move(slot(first), slot(first + firstRun), items);
+        std::move(slot(0), slot(count - firstRun), items + firstRun);
+        destroyElements(head, count);
+    }
+}
+
+template<typename T, size_t SIZE, typename STATS>
+void CircularQueue<T, SIZE, STATS>::destroyElements(std::uint64_t head, size_t count) {
+    if constexpr(!std::is_trivially_destructible_v<T>) {
+        const size_t first = index(head);
+        const size_t firstRun = std::min(count, SIZE - first);
+        std::destroy_n(slot(first), firstRun);
+        std::destroy_n(slot(0), count - firstRun);
+    }
 }
 
 #endif //STATICCOLLECTIONS_CIRCULARQUEUE_H
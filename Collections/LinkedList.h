@@ -7,8 +7,10 @@
 #include "List.h"
 
 template <class T>
-class LinkedList: public List<T> { //: public List<T> {
+class LinkedList {
 public:
+    typedef T value_type;
+
     struct Node {
         T mElement = {};
         Node *mNext = nullptr;
@@ -157,7 +159,7 @@ public:
         }
     };
 
-    virtual LinkedList<T> &operator=(const LinkedList<T> &other) {
+    LinkedList<T> &operator=(const LinkedList<T> &other) {
         //make sure to release all the held node back to the allocator.
         clear();
         
@@ -168,11 +170,11 @@ public:
         return *this;
     };
     
-    [[nodiscard]] bool empty() const override { return mHead == &mEnd; }
-    [[nodiscard]] bool isFull() const override { return mAllocator.size() < sizeof(Node);}
-    [[nodiscard]] size_t size() const override { return mNumElements; }
+    [[nodiscard]] bool empty() const { return mHead == &mEnd; }
+    [[nodiscard]] bool isFull() const { return mAllocator.size() < sizeof(Node);}
+    [[nodiscard]] size_t size() const { return mNumElements; }
 
-    void push_back(const T &elem) override {
+    void push_back(const T &elem) {
         // Create the new Node.
         auto newNode = mAllocator.alloc();
 
@@ -193,7 +195,7 @@ public:
         }
     }
 
-    void pop_back() override {
+    void pop_back() {
         if(!empty()) {
             //There is at least one element
             mNumElements--;
@@ -209,7 +211,7 @@ public:
         }
     }
 
-    void push_front(const T &elem) override {
+    void push_front(const T &elem) {
         // Create the new Node.
         auto newNode = mAllocator.alloc();
 
@@ -227,7 +229,7 @@ public:
         mHead = newNode;
     }
 
-    void pop_front() override {
+    void pop_front() {
         if(!empty()) {
             //There is at least one element
             mNumElements--;
@@ -242,41 +244,41 @@ public:
         }
     }
 
-    void clear() override {
+    void clear() {
         while(mHead != &mEnd) {
             eraseAtIndex(0);
         }
     }
 
-    const T &front() const override {
+    const T &front() const {
         if(empty()) {
             throw std::underflow_error("List is empty");
         }
         return mHead->mElement;
     }
 
-    const T &back() const override {
+    const T &back() const {
         if(empty()) {
             throw std::underflow_error("List is empty");
         }
         return mEnd.mPrev->mElement;
     }
 
-    T &front() override {
+    T &front() {
         if(empty()) {
             throw std::underflow_error("List is empty");
         }
         return mHead->mElement;
     }
 
-    T &back() override {
+    T &back() {
         if(empty()) {
             throw std::underflow_error("List is empty");
         }
         return mEnd.mPrev->mElement;
     }
 
-    void erase(const T &elem) override {
+    void erase(const T &elem) {
         if(empty()) {
             return;
         }
@@ -289,7 +291,7 @@ public:
         }
     }
 
-    void eraseAtIndex(std::size_t index) override {
+    void eraseAtIndex(std::size_t index) {
         if(empty()) {
             return;
         }
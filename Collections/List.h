@@ -2,30 +2,95 @@
 #define STATICCOLLECTIONS_LIST_H
 
 #include <array>
+#include <concepts>
 #include <cstdlib>
 #include <iterator>
 #include <cstring>
 
+/**
+ * The interface every list in the library provides, checked at compile time.  The lists have no virtual functions,
+ * so calls on a concrete list (or in a template constrained by ListType) are direct and can be inlined.
+ */
+template<typename L>
+concept ListType = requires(L &list, const L &constList, const typename L::value_type &elem, std::size_t index) {
+    { constList.empty() } -> std::same_as<bool>;
+    { constList.isFull() } -> std::same_as<bool>;
+    { constList.size() } -> std::same_as<std::size_t>;
+    list.push_back(elem);
+    list.pop_back();
+    list.push_front(elem);
+    list.pop_front();
+    list.clear();
+    list.erase(elem);
+    list.eraseAtIndex(index);
+    { constList.front() } -> std::same_as<const typename L::value_type &>;
+    { constList.back() } -> std::same_as<const typename L::value_type &>;
+    { list.front() } -> std::same_as<typename L::value_type &>;
+    { list.back() } -> std::same_as<typename L::value_type &>;
+};
+
+/**
+ * Type erased reference to any ListType with elements of type T, for code that must pick a list at run time.  Each
+ * call goes through a table of function pointers; the List doesn't own the list it refers to, which must outlive it.
+ */
 template <class T>
 class List {
 
 public:
     typedef T value_type;
 
-    [[nodiscard]] virtual bool empty() const = 0;
-    [[nodiscard]] virtual bool isFull() const = 0;
-    [[nodiscard]] virtual std::size_t size() const = 0;
-    virtual void push_back(const T &elem) = 0;
-    virtual void pop_back() = 0;
-    virtual void push_front(const T &elem) = 0;
-    virtual void pop_front() = 0;
-    virtual void clear() = 0;
-    virtual void erase(const T &elem) = 0;
-    virtual void eraseAtIndex(std::size_t index) = 0;
-    virtual const T &front() const = 0;
-    virtual const T &back() const = 0;
-    virtual T &front() = 0;
-    virtual T &back() = 0;
+    template<ListType L> requires std::same_as<typename L::value_type, T> && (!std::same_as<L, List>)
+    List(L &list): mList(&list), mOps(&OPS<L>) {}    // NOLINT(google-explicit-constructor)
+
+    [[nodiscard]] bool empty() const { return mOps->empty(mList); }
+    [[nodiscard]] bool isFull() const { return mOps->isFull(mList); }
+    [[nodiscard]] std::size_t size() const { return mOps->size(mList); }
+    void push_back(const T &elem) { mOps->push_back(mList, elem); }
+    void pop_back() { mOps->pop_back(mList); }
+    void push_front(const T &elem) { mOps->push_front(mList, elem); }
+    void pop_front() { mOps->pop_front(mList); }
+    void clear() { mOps->clear(mList); }
+    void erase(const T &elem) { mOps->erase(mList, elem); }
+    void eraseAtIndex(std::size_t index) { mOps->eraseAtIndex(mList, index); }
+    const T &front() const { return mOps->front(mList); }
+    const T &back() const { return mOps->back(mList); }
+    T &front() { return mOps->front(mList); }
+    T &back() { return mOps->back(mList); }
+
+private:
+    struct Ops {
+        bool (*empty)(const void *);
+        bool (*isFull)(const void *);
+        std::size_t (*size)(const void *);
+        void (*push_back)(void *, const T &);
+        void (*pop_back)(void *);
+        void (*push_front)(void *, const T &);
+        void (*pop_front)(void *);
+        void (*clear)(void *);
+        void (*erase)(void *, const T &);
+        void (*eraseAtIndex)(void *, std::size_t);
+        T &(*front)(void *);
+        T &(*back)(void *);
+    };
+
+    template<typename L>
+    static constexpr Ops OPS{
+        [](const void *l) { return static_cast<const L *>(l)->empty(); },
+        [](const void *l) { return static_cast<const L *>(l)->isFull(); },
+        [](const void *l) { return static_cast<const L *>(l)->size(); },
+        [](void *l, const T &elem) { static_cast<L *>(l)->push_back(elem); },
+        [](void *l) { static_cast<L *>(l)->pop_back(); },
+        [](void *l, const T &elem) { static_cast<L *>(l)->push_front(elem); },
+        [](void *l) { static_cast<L *>(l)->pop_front(); },
+        [](void *l) { static_cast<L *>(l)->clear(); },
+        [](void *l, const T &elem) { static_cast<L *>(l)->erase(elem); },
+        [](void *l, std::size_t index) { static_cast<L *>(l)->eraseAtIndex(index); },
+        [](void *l) -> T & { return static_cast<L *>(l)->front(); },
+        [](void *l) -> T & { return static_cast<L *>(l)->back(); }
+    };
+
+    void *mList;
+    const Ops *mOps;
 };
 
-#endif //STATICCOLLECTIONS_LIST_H
\ No newline at end of file
+#endif //STATICCOLLECTIONS_LIST_H
@@ -0,0 +1,150 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_MESSAGERING_H
+#define STATICCOLLECTIONS_MESSAGERING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include "CircularQueue.h"
+
+/**
+ * Single-producer/single-consumer ring of variable length messages, packed into a CircularQueue<uint8_t>.
+ *
+ * Each message is stored as a record: an ALIGNMENT sized header holding the payload length, followed by the payload,
+ * padded to a multiple of ALIGNMENT.  Records never straddle the end of the storage; when a record doesn't fit in
+ * the space before the wrap point, the producer fills that space with a skip record and writes the message at the
+ * start of the storage.  So the consumer always gets a whole message as one contiguous, ALIGNMENT aligned view into
+ * the ring, without copying:
+ *
+ * while(auto message = ring.tryRead()) {
+ *      handle(*message);
+ *      ring.release();
+ * }
+ */
+template<size_t SIZE>
+class MessageRing {
+public:
+    static constexpr size_t ALIGNMENT = 8;
+    static constexpr size_t HEADER_SIZE = ALIGNMENT;
+    static constexpr size_t MAX_MESSAGE_SIZE = SIZE - HEADER_SIZE;
+    static_assert(SIZE % ALIGNMENT == 0 && SIZE > HEADER_SIZE, "MessageRing SIZE must be a multiple of ALIGNMENT.");
+
+    /**
+     * Copies message into the ring as one record.  A record of up to half the ring always fits once the consumer
+     * has drained it; a larger one also needs the free space to start near the beginning of the storage, so a
+     * producer that retries until it succeeds should keep messages to SIZE / 2 - HEADER_SIZE bytes.
+     *
+     * @return false if the message is larger than MAX_MESSAGE_SIZE or there isn't room for it right now.
+     */
+    bool tryWrite(std::span<const uint8_t> message);
+
+    /**
+     * Gets the oldest message in the ring without copying it.  The view stays valid, and the message stays in the
+     * ring, until release() is called.
+     *
+     * @return the message payload, or std::nullopt if the ring is empty.
+     */
+    std::optional<std::span<const uint8_t>> tryRead();
+
+    /**
+     * Removes the message returned by the last tryRead() from the ring.
+     */
+    void release() {
+        mQueue.popElements(mPendingRecordSize);
+        mPendingRecordSize = 0;
+    }
+
+    [[nodiscard]] bool empty() const { return mQueue.empty(); }
+
+    // Not thread safe; neither producer nor consumer may be active.
+    void clear() {
+        mQueue.clear();
+        mWriteOffset = 0;
+        mPendingRecordSize = 0;
+    }
+
+private:
+    static constexpr std::uint32_t SKIP = 0xFFFFFFFF;   // header length of a record that pads out to the wrap point
+
+    struct Header {
+        std::uint32_t mLength;
+        std::uint32_t mSkipSize;    // of a SKIP record: the bytes to pop, itself included, to reach the wrap point
+    };
+    static_assert(sizeof(Header) <= HEADER_SIZE);
+
+    static constexpr size_t recordSize(size_t length) {
+        return HEADER_SIZE + (length + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    static void writeHeader(uint8_t *dest, std::uint32_t length, std::uint32_t skipSize = 0) {
+        const Header header{length, skipSize};
+        std::memcpy(dest, &header, sizeof(header));
+    }
+
+    CircularQueue<uint8_t, SIZE> mQueue;
+    size_t mWriteOffset{0};          // producer only, where the next record goes in the storage
+    size_t mPendingRecordSize{0};    // consumer only
+};
+
+template<size_t SIZE>
+bool MessageRing<SIZE>::tryWrite(std::span<const uint8_t> message) {
+    if(message.size() > MAX_MESSAGE_SIZE) {
+        return false;
+    }
+    const size_t total = recordSize(message.size());
+
+    // Records are aligned and SIZE is a multiple of ALIGNMENT, so the space before the wrap point always has room for
+    // a skip header.
+    auto block = mQueue.reserveBlock(total);
+    if(block.size() < total) {
+        // The block stops at the consumer or at the wrap point; only the latter is worth skipping, and only if the
+        // record then fits at the start of the storage.  reserveBlock() may have stopped short of the wrap point at
+        // a stale copy of the consumer's index, so both are decided from the write offset rather than the block.
+        const size_t toWrap = SIZE - mWriteOffset;
+        if(block.size() != toWrap || SIZE - mQueue.size() < toWrap + total) {
+            return false;
+        }
+        writeHeader(block.data(), SKIP, (std::uint32_t)toWrap);
+        mQueue.commit(toWrap);
+        mWriteOffset = 0;
+        block = mQueue.reserveBlock(total);
+        if(block.size() < total) {
+            return false;
+        }
+    }
+
+    writeHeader(block.data(), (std::uint32_t)message.size());
+    if(!message.empty()) {
+        std::memcpy(block.data() + HEADER_SIZE, message.data(), message.size());
+    }
+    mQueue.commit(total);
+    mWriteOffset = (mWriteOffset + total) % SIZE;
+    return true;
+}
+
+template<size_t SIZE>
+std::optional<std::span<const uint8_t>> MessageRing<SIZE>::tryRead() {
+    for(;;) {
+        const auto block = mQueue.getBlock();
+        if(block.empty()) {
+            return std::nullopt;
+        }
+
+        Header header{};
+        std::memcpy(&header, block.data(), sizeof(header));
+        if(header.mLength == SKIP) {
+            mQueue.popElements(header.mSkipSize);
+            continue;
+        }
+
+        mPendingRecordSize = recordSize(header.mLength);
+        return block.subspan(HEADER_SIZE, header.mLength);
+    }
+}
+
+#endif //STATICCOLLECTIONS_MESSAGERING_H
@@ -0,0 +1,285 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_MIRROREDCIRCULARQUEUE_H
+#define STATICCOLLECTIONS_MIRROREDCIRCULARQUEUE_H
+
+#if defined(__linux__)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <cerrno>
+#include <initializer_list>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "CacheLine.h"
+#include "QueueIndices.h"
+
+/**
+ * Linux variant of CircularQueue whose storage is mapped twice, back to back, in virtual memory (a memfd mapped at
+ * base and again at base + SIZE * sizeof(T)).  Writing past the end of the first view lands at the start of the
+ * storage, so every readable and writable region is a single contiguous span: getBlock() always returns every
+ * element in the queue and reserveBlock() all of the free space, wrapped or not.
+ *
+ * The public API and the single-producer/single-consumer rules are the same as CircularQueue, so the two can be
+ * swapped with a typedef.  Unlike CircularQueue the storage is allocated with mmap when the queue is constructed, T
+ * must be trivially copyable, and SIZE * sizeof(T) must be a multiple of the page size.
+ */
+template<typename T, size_t SIZE>
+class MirroredCircularQueue final {
+    static_assert(std::is_trivially_copyable_v<T>, "MirroredCircularQueue elements must be trivially copyable.");
+
+public:
+    typedef T value_type;
+    enum {CAPACITY = SIZE};
+
+    MirroredCircularQueue() { mapStorage(); }
+    MirroredCircularQueue(const std::initializer_list<T> &initializerList) {
+        if(initializerList.size() > SIZE) {
+            throw std::runtime_error("number of initializer elements exceeds capacity.");
+        }
+
+        mapStorage();
+        push(initializerList.begin(), initializerList.size());
+    }
+    ~MirroredCircularQueue() { munmap(mArray, 2 * BYTES); }
+
+    // Not thread safe; neither producer nor consumer may be active.
+    void clear() { mIndices.clear(); }
+    bool push(const T& item) { return push(&item, 1); }
+    bool push(T&& item) { return push(&item, 1); }
+    bool push(const T* items, size_t count);
+    bool pop(T& item) { return pop(&item, 1); }
+    bool pop(T* items, size_t count);
+    bool popElements(size_t count);
+    bool peek(T& item);
+
+    /**
+     * Constructs an element in place at the tail from args.
+     *
+     * @return false, without constructing anything, if the queue is full.
+     */
+    template<typename... ARGS>
+    bool emplace(ARGS&&... args);
+
+    /**
+     * Pops the front element.
+     *
+     * @return the element, or std::nullopt if the queue is empty.
+     */
+    std::optional<T> pop();
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] bool full() const { return size() == SIZE; }
+    [[nodiscard]] size_t size() const { return mIndices.size(); }
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+    size_t pushUpTo(const T* items, size_t count);
+    size_t popUpTo(T* items, size_t count);
+
+    /**
+     * Gets a span of every element in the queue.  Unlike CircularQueue::getBlock() the span never stops at the end of
+     * the physical storage, so one call followed by popElements() drains the queue.
+     */
+    std::span<T const> getBlock() const {
+        const auto head = mIndices.head();
+        return {mArray + index(head), mIndices.publishedTail() - head};
+    }
+
+    template<typename FN>
+    size_t consume(FN &&fn, size_t maxCount);
+    template<typename FN>
+    size_t consume_all(FN &&fn) { return consume(std::forward<FN>(fn), SIZE); }
+
+    /**
+     * Gets a writable span over all of the free space in the queue (limited to maxCount), see
+     * CircularQueue::reserveBlock().  The span is always contiguous.
+     */
+    std::span<T> reserveBlock(size_t maxCount = SIZE) {
+        const auto tail = mIndices.tail();
+        return {mArray + index(tail), std::min(maxCount, mIndices.freeSpace(tail, maxCount))};
+    }
+
+    bool commit(size_t count) { return mIndices.commit(count); }
+
+private:
+    static constexpr size_t BYTES = SIZE * sizeof(T);
+
+    void mapStorage();
+
+    [[nodiscard]] static constexpr size_t index(std::uint64_t counter) { return QueueIndices<SIZE>::index(counter); }
+
+    QueueIndices<SIZE> mIndices;
+
+    alignas(CACHE_LINE_SIZE) T *mArray{nullptr};              // 2 * SIZE elements, the second half mirroring the first
+};
+
+template<typename T, size_t SIZE>
+void MirroredCircularQueue<T, SIZE>::mapStorage() {
+    const auto pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    if(BYTES % pageSize != 0) {
+        throw std::invalid_argument("MirroredCircularQueue storage must be a multiple of the page size.");
+    }
+
+    const int fd = memfd_create("MirroredCircularQueue", MFD_CLOEXEC);
+    if(fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "memfd_create");
+    }
+    if(ftruncate(fd, BYTES) != 0) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+
+    // Reserve address space for both views, then map the file over each half of it.
+    auto *base = (uint8_t *)mmap(nullptr, 2 * BYTES, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(base == MAP_FAILED) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "mmap");
+    }
+    for(uint8_t *view: {base, base + BYTES}) {
+        if(mmap(view, BYTES, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            const int error = errno;
+            munmap(base, 2 * BYTES);
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+    }
+    close(fd);
+
+    mArray = (T *)base;
+}
+
+// All or nothing, published with a single tail store.
+template<typename T, size_t SIZE>
+bool MirroredCircularQueue<T, SIZE>::push(const T *items, size_t count) {
+    if(!items) {
+        return false;
+    }
+    const auto current_tail = mIndices.tail();
+    if(mIndices.freeSpace(current_tail, count) < count) {
+        return false;
+    }
+    std::memcpy(mArray + index(current_tail), items, count * sizeof(T));
+    mIndices.publishTail(current_tail + count);
+    return true;
+}
+
+template<typename T, size_t SIZE>
+template<typename... ARGS>
+bool MirroredCircularQueue<T, SIZE>::emplace(ARGS&&... args) {
+    const auto current_tail = mIndices.tail();
+    if(mIndices.freeSpace(current_tail, 1) == 0) {
+        return false;
+    }
+    new(mArray + index(current_tail)) T(std::forward<ARGS>(args)...);
+    mIndices.publishTail(current_tail + 1);
+    return true;
+}
+
+template<typename T, size_t SIZE>
+size_t MirroredCircularQueue<T, SIZE>::pushUpTo(const T *items, size_t count) {
+    if(!items) {
+        return 0;
+    }
+    const auto current_tail = mIndices.tail();
+    count = std::min(count, mIndices.freeSpace(current_tail, count));
+    std::memcpy(mArray + index(current_tail), items, count * sizeof(T));
+    mIndices.publishTail(current_tail + count);
+    return count;
+}
+
+// Pop by Consumer can only update the head.  All or nothing.
+template<typename T, size_t SIZE>
+bool MirroredCircularQueue<T, SIZE>::pop(T *items, size_t count) {
+    if(!items) {
+        return false;
+    }
+    const auto current_head = mIndices.head();
+    if(mIndices.available(current_head, count) < count) {
+        return false;   // not enough elements
+    }
+    std::memcpy(items, mArray + index(current_head), count * sizeof(T));
+    mIndices.publishHead(current_head + count);
+    return true;
+}
+
+// Pop by Consumer can only update the head
+template<typename T, size_t SIZE>
+std::optional<T> MirroredCircularQueue<T, SIZE>::pop() {
+    const auto current_head = mIndices.head();
+    if(mIndices.available(current_head, 1) == 0) {
+        return std::nullopt;    // empty queue
+    }
+    std::optional<T> item{mArray[index(current_head)]};
+    mIndices.publishHead(current_head + 1);
+    return item;
+}
+
+// Pop by Consumer can only update the head
+template<typename T, size_t SIZE>
+size_t MirroredCircularQueue<T, SIZE>::popUpTo(T *items, size_t count) {
+    if(!items) {
+        return 0;
+    }
+    const auto current_head = mIndices.head();
+    count = std::min(count, mIndices.available(current_head, count));
+    std::memcpy(items, mArray + index(current_head), count * sizeof(T));
+    mIndices.publishHead(current_head + count);
+    return count;
+}
+
+// Pop by Consumer can only update the head
+template<typename T, size_t SIZE>
+template<typename FN>
+size_t MirroredCircularQueue<T, SIZE>::consume(FN &&fn, size_t maxCount) {
+    const auto current_head = mIndices.head();
+    const size_t count = std::min(maxCount, mIndices.available(current_head, maxCount));
+    T *block = mArray + index(current_head);
+
+    size_t consumed = 0;
+    try {
+        for(; consumed < count; consumed++) {
+            fn(block[consumed]);
+        }
+    } catch(...) {
+        mIndices.publishHead(current_head + consumed);
+        throw;
+    }
+
+    mIndices.publishHead(current_head + count);
+    return count;
+}
+
+// Pop by Consumer can only update the head
+template<typename T, size_t SIZE>
+bool MirroredCircularQueue<T, SIZE>::popElements(size_t count) {
+    const auto current_head = mIndices.head();
+    mIndices.publishHead(current_head + std::min(count, mIndices.available(current_head, count)));
+    return true;
+}
+
+template<typename T, size_t SIZE>
+bool MirroredCircularQueue<T, SIZE>::peek(T &item) {
+    const auto current_head = mIndices.head();
+    if(mIndices.available(current_head, 1) == 0) {
+        return false;   // empty queue
+    }
+    item = mArray[index(current_head)];
+    return true;
+}
+
+#endif //defined(__linux__)
+
+#endif //STATICCOLLECTIONS_MIRROREDCIRCULARQUEUE_H
@@ -0,0 +1,225 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_OVERWRITECIRCULARQUEUE_H
+#define STATICCOLLECTIONS_OVERWRITECIRCULARQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include "CacheLine.h"
+
+/**
+ * Lossy single-producer/single-consumer queue that keeps the newest SIZE elements, for telemetry and flight recorder
+ * buffers.  push() never blocks or fails: when the queue is full it overwrites the oldest element.
+ *
+ * The producer never looks at the consumer's index.  Instead every slot carries a sequence number, written odd while
+ * the producer is storing into the slot and even once the element for a position is complete.  The consumer checks
+ * the sequence before and after copying an element out (seqlock style), so it detects both elements that were
+ * overwritten before it got to them and an element overwritten while it was being copied.  Lost elements are skipped
+ * and counted by overwritten().
+ *
+ * T must be trivially copyable, since the consumer may copy a slot while the producer is overwriting it (the copy is
+ * discarded when the sequence check fails).
+ */
+template<typename T, size_t SIZE>
+class OverwriteCircularQueue final {
+    static_assert(std::is_trivially_copyable_v<T>, "OverwriteCircularQueue elements must be trivially copyable.");
+
+public:
+    typedef T value_type;
+    enum {CAPACITY = SIZE};
+
+    OverwriteCircularQueue() = default;
+    OverwriteCircularQueue(const std::initializer_list<T> &initializerList) {
+        if(initializerList.size() > SIZE) {
+            throw std::runtime_error("number of initializer elements exceeds capacity.");
+        }
+
+        for(const T* elem = initializerList.begin(); elem != initializerList.end(); elem++) {
+            this->push(*elem);
+        }
+    }
+
+    // Not thread safe; neither producer nor consumer may be active.
+    void clear() {
+        for(auto &slot: mSlots) {
+            slot.mSequence.store(0, std::memory_order_relaxed);
+        }
+        mTail.store(0, std::memory_order_relaxed);
+        mHead.store(0, std::memory_order_relaxed);
+        mOverwritten.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Pushes item, overwriting the oldest element if the queue is full.
+     *
+     * @return always true.
+     */
+    bool push(const T& item);
+
+    /**
+     * Pushes every item.  If count exceeds the free space, the oldest elements (possibly including the first items)
+     * are overwritten.
+     *
+     * @return false only if items is null.
+     */
+    bool push(const T* items, size_t count);
+    bool pop(T& item) { return read(item, true); }
+
+    /**
+     * Pops count elements.  Elements overwritten during the call are skipped, so this can run out part way through.
+     *
+     * @return false if the queue held fewer than count elements, in which case nothing is popped, or ran out part way.
+     */
+    bool pop(T* items, size_t count);
+    bool popElements(size_t count);
+    bool peek(T& item) { return read(item, false); }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] bool full() const { return size() == SIZE; }
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+    /**
+     * Total number of elements the consumer lost because the producer overwrote them first.  May be read from any
+     * thread.
+     */
+    [[nodiscard]] std::uint64_t overwritten() const { return mOverwritten.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic_uint64_t mSequence{0};   // 2 * position + 1 while writing, 2 * position + 2 once complete
+        T mValue;
+    };
+
+    bool read(T& item, bool advance);
+
+    // Consumer only.  Moves the head past position, counting the elements between as lost.
+    void skipTo(std::uint64_t head, std::uint64_t position) {
+        mOverwritten.store(mOverwritten.load(std::memory_order_relaxed) + (position - head),
+                           std::memory_order_relaxed);
+        mHead.store(position, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static constexpr size_t index(std::uint64_t counter) {
+        if constexpr((SIZE & (SIZE - 1)) == 0) {
+            return counter & (SIZE - 1);
+        } else {
+            return counter % SIZE;
+        }
+    }
+
+    // Producer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mTail{0};   // count of elements ever pushed
+
+    // Consumer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mHead{0};   // position of the next element to pop
+    std::atomic_uint64_t mOverwritten{0};
+
+    alignas(CACHE_LINE_SIZE) Slot mSlots[SIZE];
+};
+
+template<typename T, size_t SIZE>
+bool OverwriteCircularQueue<T, SIZE>::push(const T &item) {
+    const auto position = mTail.load(std::memory_order_relaxed);
+    Slot &slot = mSlots[index(position)];
+    slot.mSequence.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.mValue = item;
+    slot.mSequence.store(2 * position + 2, std::memory_order_release);
+    mTail.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, size_t SIZE>
+bool OverwriteCircularQueue<T, SIZE>::push(const T *items, size_t count) {
+    if(!items) {
+        return false;
+    }
+    // Items that would be overwritten by later items in the same call are never written.
+    if(count > SIZE) {
+        mTail.store(mTail.load(std::memory_order_relaxed) + (count - SIZE), std::memory_order_release);
+        items += count - SIZE;
+        count = SIZE;
+    }
+    while(count--) {
+        push(*items++);
+    }
+    return true;
+}
+
+// Consumer only
+template<typename T, size_t SIZE>
+bool OverwriteCircularQueue<T, SIZE>::read(T &item, bool advance) {
+    auto head = mHead.load(std::memory_order_relaxed);
+    for(;;) {
+        const auto tail = mTail.load(std::memory_order_acquire);
+        if(head == tail) {
+            return false;   // empty queue
+        }
+        if(tail - head > SIZE) {
+            skipTo(head, tail - SIZE);
+            head = tail - SIZE;
+        }
+
+        const Slot &slot = mSlots[index(head)];
+        const auto expected = 2 * head + 2;
+        const auto before = slot.mSequence.load(std::memory_order_acquire);
+        if(before == expected) {
+            const T copy = slot.mValue;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(slot.mSequence.load(std::memory_order_relaxed) == expected) {
+                item = copy;
+                if(advance) {
+                    mHead.store(head + 1, std::memory_order_relaxed);
+                }
+                return true;
+            }
+        }
+
+        // The producer has started writing a newer position into the slot, so this element is lost.
+        skipTo(head, head + 1);
+        head++;
+    }
+}
+
+template<typename T, size_t SIZE>
+bool OverwriteCircularQueue<T, SIZE>::pop(T *items, size_t count) {
+    if(!items || size() < count) {
+        return false;
+    }
+    for(size_t i = 0; i < count; i++) {
+        if(!pop(items[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Consumer only.  Discards up to count of the oldest surviving elements.
+template<typename T, size_t SIZE>
+bool OverwriteCircularQueue<T, SIZE>::popElements(size_t count) {
+    auto head = mHead.load(std::memory_order_relaxed);
+    const auto tail = mTail.load(std::memory_order_acquire);
+    if(tail - head > SIZE) {
+        skipTo(head, tail - SIZE);
+        head = tail - SIZE;
+    }
+    mHead.store(head + std::min<std::uint64_t>(count, tail - head), std::memory_order_relaxed);
+    return true;
+}
+
+template<typename T, size_t SIZE>
+size_t OverwriteCircularQueue<T, SIZE>::size() const {
+    const auto head = mHead.load(std::memory_order_relaxed);
+    const auto tail = mTail.load(std::memory_order_acquire);
+    return tail > head ? std::min<std::uint64_t>(tail - head, SIZE) : 0;
+}
+
+#endif //STATICCOLLECTIONS_OVERWRITECIRCULARQUEUE_H
@@ -6,21 +6,96 @@
 #define STATICCOLLECTIONS_QUEUE_H
 
 #include <cstdio>
+#include <concepts>
+#include <type_traits>
 
+/**
+ * The interface every queue in the library provides, checked at compile time.  The queues are final classes with no
+ * virtual functions, so code written against a concrete queue (or a template constrained by QueueType) gets direct,
+ * inlinable calls and no vptr.
+ */
+template<typename Q>
+concept QueueType = requires(Q &queue, const Q &constQueue, typename Q::value_type &item,
+                             const typename Q::value_type &constItem, typename Q::value_type *items,
+                             const typename Q::value_type *constItems, size_t count) {
+    queue.clear();
+    { queue.push(constItem) } -> std::same_as<bool>;
+    { queue.push(constItems, count) } -> std::same_as<bool>;
+    { queue.pop(item) } -> std::same_as<bool>;
+    { queue.pop(items, count) } -> std::same_as<bool>;
+    { queue.popElements(count) } -> std::same_as<bool>;
+    { queue.peek(item) } -> std::same_as<bool>;
+    { constQueue.empty() } -> std::same_as<bool>;
+    { constQueue.full() } -> std::same_as<bool>;
+    { constQueue.size() } -> std::same_as<size_t>;
+    { constQueue.capacity() } -> std::same_as<size_t>;
+};
+
+/**
+ * Type erased reference to any QueueType with elements of type T, for the places that need to choose a queue at run
+ * time or keep differently sized queues behind one type.  Every call goes through a table of function pointers, the
+ * cost the queues used to pay on every call through their virtual base.  The Queue doesn't own the queue it refers
+ * to, which must outlive it.
+ *
+ * CircularQueue<int, 16> circular;
+ * StaticMPMCQueue<int, 64> shared;
+ * Queue<int> queues[]{circular, shared};
+ */
 template <class T>
 class Queue {
 public:
-    virtual void clear() = 0;
-    virtual bool push(const T& item) = 0;
-    virtual bool push(const T* items, size_t count) = 0;
-    virtual bool pop(T& item) = 0;
-    virtual bool popElements(size_t count) = 0;
-    virtual bool peek(T& item) = 0;
-
-    [[nodiscard]] virtual bool empty() const = 0;
-    [[nodiscard]] virtual bool full() const = 0;
-    [[nodiscard]] virtual size_t size() const = 0;
-    [[nodiscard]] virtual size_t capacity() const = 0;
+    typedef T value_type;
+
+    template<QueueType Q> requires std::same_as<typename Q::value_type, T> && (!std::same_as<Q, Queue>)
+    Queue(Q &queue): mQueue(&queue), mOps(&OPS<Q>) {}    // NOLINT(google-explicit-constructor)
+
+    void clear() { mOps->clear(mQueue); }
+    bool push(const T& item) { return mOps->push(mQueue, item); }
+    bool push(const T* items, size_t count) { return mOps->pushItems(mQueue, items, count); }
+    bool pop(T& item) { return mOps->pop(mQueue, item); }
+    bool pop(T* items, size_t count) { return mOps->popItems(mQueue, items, count); }
+    bool popElements(size_t count) { return mOps->popElements(mQueue, count); }
+    bool peek(T& item) { return mOps->peek(mQueue, item); }
+
+    [[nodiscard]] bool empty() const { return mOps->empty(mQueue); }
+    [[nodiscard]] bool full() const { return mOps->full(mQueue); }
+    [[nodiscard]] size_t size() const { return mOps->size(mQueue); }
+    [[nodiscard]] size_t capacity() const { return mOps->capacity(mQueue); }
 
+private:
+    struct Ops {
+        void (*clear)(void *);
+        bool (*push)(void *, const T &);
+        bool (*pushItems)(void *, const T *, size_t);
+        bool (*pop)(void *, T &);
+        bool (*popItems)(void *, T *, size_t);
+        bool (*popElements)(void *, size_t);
+        bool (*peek)(void *, T &);
+        bool (*empty)(const void *);
+        bool (*full)(const void *);
+        size_t (*size)(const void *);
+        size_t (*capacity)(const void *);
+    };
+
+    template<typename Q>
+    static constexpr Ops OPS{
+        [](void *q) { static_cast<Q *>(q)->clear(); },
+        [](void *q, const T &item) { return static_cast<Q *>(q)->push(item); },
+        [](void *q, const T *items, size_t count) { return static_cast<Q *>(q)->push(items, count); },
+        [](void *q, T &item) { return static_cast<Q *>(q)->pop(item); },
+        [](void *q, T *items, size_t count) { return static_cast<Q *>(q)->pop(items, count); },
+        [](void *q, size_t count) { return static_cast<Q *>(q)->popElements(count); },
+        [](void *q, T &item) { return static_cast<Q *>(q)->peek(item); },
+        [](const void *q) { return static_cast<const Q *>(q)->empty(); },
+        [](const void *q) { return static_cast<const Q *>(q)->full(); },
+        [](const void *q) { return static_cast<const Q *>(q)->size(); },
+        [](const void *q) { return static_cast<const Q *>(q)->capacity(); }
+    };
+
+    void *mQueue;
+    const Ops *mOps;
 };
+
+static_assert(QueueType<Queue<int>>);
+
 #endif //STATICCOLLECTIONS_QUEUE_H
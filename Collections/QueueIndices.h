@@ -0,0 +1,113 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_QUEUEINDICES_H
+#define STATICCOLLECTIONS_QUEUEINDICES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include "CacheLine.h"
+
+/**
+ * The head and tail of a single-producer/single-consumer ring of SIZE slots, for queues that keep their elements
+ * somewhere else (MirroredCircularQueue's double mapping, SharedCircularQueue's inline array).  As in CircularQueue
+ * both are free-running 64 bit counters, each on its own cache line next to a private copy of the opposite index
+ * that is only refreshed when the ring looks full (producer) or empty (consumer).
+ *
+ * Holds no pointers, so it can live in memory shared between processes.  Producer functions read the tail with
+ * tail(), check freeSpace(), write the slots and then publishTail(); consumer functions mirror that with head(),
+ * available() and publishHead().
+ */
+template<size_t SIZE>
+class QueueIndices {
+public:
+    // Maps a free-running counter onto a slot.
+    [[nodiscard]] static constexpr size_t index(std::uint64_t counter) {
+        if constexpr((SIZE & (SIZE - 1)) == 0) {
+            return counter & (SIZE - 1);
+        } else {
+            return counter % SIZE;
+        }
+    }
+
+    // Not thread safe; neither producer nor consumer may be active.
+    void clear() {
+        mTail.store(0, std::memory_order_relaxed);
+        mHead.store(0, std::memory_order_relaxed);
+        mCachedHead = 0;
+        mCachedTail = 0;
+    }
+
+    // Producer only.
+    [[nodiscard]] std::uint64_t tail() const { return mTail.load(std::memory_order_relaxed); }
+
+    /**
+     * Producer only.  Free slots after tail, re-reading the consumer's head only if the cached copy shows fewer than
+     * wanted.
+     */
+    [[nodiscard]] size_t freeSpace(std::uint64_t tail, size_t wanted) {
+        if(SIZE - (tail - mCachedHead) < wanted) {
+            mCachedHead = mHead.load(std::memory_order_acquire);
+        }
+        return SIZE - (tail - mCachedHead);
+    }
+
+    // Producer only.  Makes the slots written up to tail visible to the consumer.
+    void publishTail(std::uint64_t tail) { mTail.store(tail, std::memory_order_release); }
+
+    /**
+     * Producer only.  Publishes count slots written after the current tail.
+     *
+     * @return false, without publishing anything, if count exceeds the free space last seen by freeSpace().
+     */
+    bool commit(size_t count) {
+        const auto current = tail();
+        if(count > SIZE - (current - mCachedHead)) {
+            return false;
+        }
+        publishTail(current + count);
+        return true;
+    }
+
+    // Consumer only.
+    [[nodiscard]] std::uint64_t head() const { return mHead.load(std::memory_order_relaxed); }
+
+    /**
+     * Consumer only.  Readable slots from head, re-reading the producer's tail only if the cached copy shows fewer
+     * than wanted.
+     */
+    [[nodiscard]] size_t available(std::uint64_t head, size_t wanted) {
+        if(mCachedTail - head < wanted) {
+            mCachedTail = mTail.load(std::memory_order_acquire);
+        }
+        return mCachedTail - head;
+    }
+
+    // Consumer only.  Hands the slots read up to head back to the producer.
+    void publishHead(std::uint64_t head) { mHead.store(head, std::memory_order_release); }
+
+    /**
+     * Consumer only, but const for getBlock(): the tail as published, without updating the cached copy.
+     */
+    [[nodiscard]] std::uint64_t publishedTail() const { return mTail.load(std::memory_order_acquire); }
+
+    [[nodiscard]] size_t size() const {
+        const auto head = mHead.load(std::memory_order_acquire);
+        const auto tail = mTail.load(std::memory_order_acquire);
+        return std::min<std::uint64_t>(tail - head, SIZE);
+    }
+
+private:
+    // Producer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mTail{0};   // count of elements ever pushed
+    std::uint64_t       mCachedHead{0};                        // producer's last observed mHead
+
+    // Consumer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mHead{0};   // count of elements ever popped
+    std::uint64_t       mCachedTail{0};                        // consumer's last observed mTail
+};
+
+#endif //STATICCOLLECTIONS_QUEUEINDICES_H
@@ -0,0 +1,111 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_QUEUESTATISTICS_H
+#define STATICCOLLECTIONS_QUEUESTATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include "CacheLine.h"
+
+/**
+ * Statistics policies for CircularQueue's STATS template parameter.
+ *
+ * A policy gets the producer side calls pushed() and pushFull() and the consumer side calls popped() and popEmpty().
+ * ENABLED tells the queue whether it needs to do any work (e.g. read the consumer's index) to feed the policy.
+ */
+
+/**
+ * The default: records nothing.  Its member functions are empty and the queue holds it as [[no_unique_address]], so
+ * a queue without statistics has the same size and code as one that never heard of them.
+ */
+struct NoQueueStatistics {
+    static constexpr bool ENABLED = false;
+
+    void pushed(size_t, size_t, size_t) {}
+    void pushFull() {}
+    void popped(size_t) {}
+    void popEmpty() {}
+};
+
+/**
+ * Counters for sizing a queue: elements enqueued and dequeued, pushes that found the queue full, pops that found it
+ * empty (for the bulk calls: that found too little room or too few elements for everything asked), the largest size
+ * reached and, if HISTOGRAM_BUCKETS is non zero, a histogram of the queue size seen by each
+ * push (bucket i counts pushes that found between i and i + 1 HISTOGRAM_BUCKETS-ths of the capacity in use).
+ *
+ * Every counter has a single writer, the producer or the consumer, and the two sets live on separate cache lines, so
+ * recording is a relaxed load and store with no read-modify-write and no sharing.  The getters may be called from any
+ * thread and return relaxed snapshots.
+ */
+template<size_t HISTOGRAM_BUCKETS = 0>
+class QueueStatistics {
+public:
+    static constexpr bool ENABLED = true;
+
+    // Producer only.  count elements were pushed into a queue that held sizeBefore of its capacity.
+    void pushed(size_t count, size_t sizeBefore, size_t capacity) {
+        bump(mEnqueued, count);
+        if(sizeBefore + count > mHighWaterMark.load(std::memory_order_relaxed)) {
+            mHighWaterMark.store(sizeBefore + count, std::memory_order_relaxed);
+        }
+        if constexpr(HISTOGRAM_BUCKETS > 0) {
+            bump(mHistogram[std::min(sizeBefore * HISTOGRAM_BUCKETS / capacity, HISTOGRAM_BUCKETS - 1)], 1);
+        }
+    }
+
+    // Producer only.
+    void pushFull() { bump(mPushFull, 1); }
+
+    // Consumer only.
+    void popped(size_t count) { bump(mDequeued, count); }
+
+    // Consumer only.
+    void popEmpty() { bump(mPopEmpty, 1); }
+
+    [[nodiscard]] std::uint64_t enqueued() const { return mEnqueued.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t dequeued() const { return mDequeued.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t pushFullCount() const { return mPushFull.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t popEmptyCount() const { return mPopEmpty.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t highWaterMark() const { return mHighWaterMark.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] std::array<std::uint64_t, HISTOGRAM_BUCKETS> histogram() const {
+        std::array<std::uint64_t, HISTOGRAM_BUCKETS> result{};
+        for(size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            result[i] = mHistogram[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // Not thread safe; neither producer nor consumer may be active.
+    void reset() {
+        for(auto *counter: {&mEnqueued, &mPushFull, &mHighWaterMark, &mDequeued, &mPopEmpty}) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+        for(auto &bucket: mHistogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    // Single writer, so no atomic read-modify-write is needed.
+    static void bump(std::atomic_uint64_t &counter, size_t count) {
+        counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    // Producer cache line(s)
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mEnqueued{0};
+    std::atomic_uint64_t mPushFull{0};
+    std::atomic_uint64_t mHighWaterMark{0};
+    std::array<std::atomic_uint64_t, HISTOGRAM_BUCKETS> mHistogram{};
+
+    // Consumer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mDequeued{0};
+    std::atomic_uint64_t mPopEmpty{0};
+};
+
+#endif //STATICCOLLECTIONS_QUEUESTATISTICS_H
@@ -0,0 +1,351 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_SHAREDCIRCULARQUEUE_H
+#define STATICCOLLECTIONS_SHAREDCIRCULARQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "CacheLine.h"
+#include "QueueIndices.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Single-producer/single-consumer queue meant to live in memory shared between processes, e.g. a POSIX shared memory
+ * segment mapped by a producer process and a consumer process.  The whole state (header, indices and elements) is
+ * stored inline with no pointers, so each process can map the segment at a different address.  Otherwise the API
+ * matches CircularQueue.
+ *
+ * The queue is never constructed directly: one process calls create() on the shared memory and the other calls
+ * attach(), which verifies the magic number, layout version, element size, capacity, queue size and cache line size
+ * written by create(), so processes built with a different layout refuse to share it.
+ */
+template<typename T, size_t SIZE>
+class SharedCircularQueue final {
+    static_assert(std::is_trivially_copyable_v<T>, "SharedCircularQueue elements must be trivially copyable.");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<size_t>::is_always_lock_free,
+                  "SharedCircularQueue needs lock-free atomics to be shared between processes.");
+
+public:
+    enum {CAPACITY = SIZE};
+    static constexpr std::uint32_t MAGIC = 0x53435121;     // "SCQ!"
+    static constexpr std::uint32_t VERSION = 2;
+
+    SharedCircularQueue(const SharedCircularQueue &) = delete;
+    SharedCircularQueue &operator=(const SharedCircularQueue &) = delete;
+
+    /**
+     * Constructs an empty queue at memory.
+     *
+     * @param memory - start of the shared memory, aligned to CACHE_LINE_SIZE (mmap'ed memory is page aligned).
+     * @param bytes - size of the memory, at least sizeof(SharedCircularQueue).
+     * @return the queue, located at memory.
+     */
+    static SharedCircularQueue *create(void *memory, size_t bytes) {
+        checkMemory(memory, bytes);
+        auto *queue = new(memory) SharedCircularQueue();
+        queue->mHeader.mMagic.store(MAGIC, std::memory_order_release);
+        return queue;
+    }
+
+    /**
+     * Gets the queue another process created at memory.
+     *
+     * @throws std::runtime_error if the memory doesn't hold a queue created by create() for the same T and SIZE, or
+     * if the creating process laid the queue out differently (e.g. it was built with another CACHE_LINE_SIZE).
+     */
+    static SharedCircularQueue *attach(void *memory, size_t bytes) {
+        checkMemory(memory, bytes);
+        auto *queue = std::launder(reinterpret_cast<SharedCircularQueue *>(memory));
+        const Header &header = queue->mHeader;
+        if(header.mMagic.load(std::memory_order_acquire) != MAGIC) {
+            throw std::runtime_error("shared memory does not contain an initialized SharedCircularQueue.");
+        }
+        if(header.mVersion != VERSION || header.mElementSize != sizeof(T) || header.mCapacity != SIZE ||
+                header.mQueueSize != sizeof(SharedCircularQueue) || header.mCacheLineSize != CACHE_LINE_SIZE) {
+            throw std::runtime_error("SharedCircularQueue layout does not match.");
+        }
+        return queue;
+    }
+
+    // Not thread safe; neither producer nor consumer may be active.
+    void clear() { mIndices.clear(); }
+    bool push(const T& item) { return push(&item, 1); }
+    bool push(T&& item) { return push(&item, 1); }
+    bool push(const T* items, size_t count);
+    size_t pushUpTo(const T* items, size_t count);
+    template<typename... ARGS>
+    bool emplace(ARGS&&... args);
+    bool pop(T& item) { return pop(&item, 1); }
+    std::optional<T> pop();
+    bool pop(T* items, size_t count);
+    size_t popUpTo(T* items, size_t count);
+    bool popElements(size_t count);
+    bool peek(T& item);
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] bool full() const { return size() == SIZE; }
+    [[nodiscard]] size_t size() const { return mIndices.size(); }
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+    /**
+     * See CircularQueue::getBlock().
+     */
+    std::span<T const> getBlock() const {
+        const auto head = mIndices.head();
+        const size_t first = index(head);
+        return {mArray + first, std::min<size_t>(mIndices.publishedTail() - head, SIZE - first)};
+    }
+
+    /**
+     * See CircularQueue::consume().  fn is called on the elements in place, in the shared memory.
+     */
+    template<typename FN>
+    size_t consume(FN &&fn, size_t maxCount);
+    template<typename FN>
+    size_t consume_all(FN &&fn) { return consume(std::forward<FN>(fn), SIZE); }
+
+    /**
+     * See CircularQueue::reserveBlock().
+     */
+    std::span<T> reserveBlock(size_t maxCount = SIZE) {
+        const auto tail = mIndices.tail();
+        const size_t first = index(tail);
+        return {mArray + first, std::min({maxCount, mIndices.freeSpace(tail, maxCount), SIZE - first})};
+    }
+
+    bool commit(size_t count) { return mIndices.commit(count); }
+
+private:
+    struct Header {
+        std::atomic_uint32_t    mMagic{0};      // written last by create()
+        std::uint32_t           mVersion{VERSION};
+        std::uint64_t           mElementSize{sizeof(T)};
+        std::uint64_t           mCapacity{SIZE};
+        std::uint64_t           mQueueSize{sizeof(SharedCircularQueue)};
+        std::uint64_t           mCacheLineSize{CACHE_LINE_SIZE};
+    };
+
+    SharedCircularQueue() = default;
+
+    static void checkMemory(void *memory, size_t bytes) {
+        if(!memory || bytes < sizeof(SharedCircularQueue)) {
+            throw std::invalid_argument("shared memory is too small for SharedCircularQueue.");
+        }
+        if((uintptr_t)memory % alignof(SharedCircularQueue) != 0) {
+            throw std::invalid_argument("shared memory is not aligned for SharedCircularQueue.");
+        }
+    }
+
+    void copyIn(std::uint64_t tail, const T* items, size_t count);
+    void copyOut(std::uint64_t head, T* items, size_t count) const;
+
+    [[nodiscard]] static constexpr size_t index(std::uint64_t counter) { return QueueIndices<SIZE>::index(counter); }
+
+    Header mHeader;
+
+    // The producer's and consumer's cached copies are each only touched by their own process.
+    QueueIndices<SIZE> mIndices;
+
+    alignas(CACHE_LINE_SIZE) T mArray[SIZE];
+};
+
+// All or nothing, published with a single tail store.
+template<typename T, size_t SIZE>
+bool SharedCircularQueue<T, SIZE>::push(const T *items, size_t count) {
+    if(!items) {
+        return false;
+    }
+    const auto current_tail = mIndices.tail();
+    if(mIndices.freeSpace(current_tail, count) < count) {
+        return false;
+    }
+    copyIn(current_tail, items, count);
+    mIndices.publishTail(current_tail + count);
+    return true;
+}
+
+template<typename T, size_t SIZE>
+size_t SharedCircularQueue<T, SIZE>::pushUpTo(const T *items, size_t count) {
+    if(!items) {
+        return 0;
+    }
+    const auto current_tail = mIndices.tail();
+    count = std::min(count, mIndices.freeSpace(current_tail, count));
+    copyIn(current_tail, items, count);
+    mIndices.publishTail(current_tail + count);
+    return count;
+}
+
+template<typename T, size_t SIZE>
+template<typename... ARGS>
+bool SharedCircularQueue<T, SIZE>::emplace(ARGS&&... args) {
+    const auto current_tail = mIndices.tail();
+    if(mIndices.freeSpace(current_tail, 1) == 0) {
+        return false;
+    }
+    new(mArray + index(current_tail)) T(std::forward<ARGS>(args)...);
+    mIndices.publishTail(current_tail + 1);
+    return true;
+}
+
+// All or nothing, published with a single head store.
+template<typename T, size_t SIZE>
+bool SharedCircularQueue<T, SIZE>::pop(T *items, size_t count) {
+    if(!items) {
+        return false;
+    }
+    const auto current_head = mIndices.head();
+    if(mIndices.available(current_head, count) < count) {
+        return false;
+    }
+    copyOut(current_head, items, count);
+    mIndices.publishHead(current_head + count);
+    return true;
+}
+
+template<typename T, size_t SIZE>
+std::optional<T> SharedCircularQueue<T, SIZE>::pop() {
+    const auto current_head = mIndices.head();
+    if(mIndices.available(current_head, 1) == 0) {
+        return std::nullopt;
+    }
+    std::optional<T> item{mArray[index(current_head)]};
+    mIndices.publishHead(current_head + 1);
+    return item;
+}
+
+template<typename T, size_t SIZE>
+size_t SharedCircularQueue<T, SIZE>::popUpTo(T *items, size_t count) {
+    if(!items) {
+        return 0;
+    }
+    const auto current_head = mIndices.head();
+    count = std::min(count, mIndices.available(current_head, count));
+    copyOut(current_head, items, count);
+    mIndices.publishHead(current_head + count);
+    return count;
+}
+
+template<typename T, size_t SIZE>
+template<typename FN>
+size_t SharedCircularQueue<T, SIZE>::consume(FN &&fn, size_t maxCount) {
+    const auto current_head = mIndices.head();
+    const size_t count = std::min(maxCount, mIndices.available(current_head, maxCount));
+
+    size_t consumed = 0;
+    try {
+        for(; consumed < count; consumed++) {
+            fn(mArray[index(current_head + consumed)]);
+        }
+    } catch(...) {
+        mIndices.publishHead(current_head + consumed);
+        throw;
+    }
+
+    mIndices.publishHead(current_head + count);
+    return count;
+}
+
+template<typename T, size_t SIZE>
+bool SharedCircularQueue<T, SIZE>::popElements(size_t count) {
+    const auto current_head = mIndices.head();
+    mIndices.publishHead(current_head + std::min(count, mIndices.available(current_head, count)));
+    return true;
+}
+
+template<typename T, size_t SIZE>
+bool SharedCircularQueue<T, SIZE>::peek(T &item) {
+    const auto current_head = mIndices.head();
+    if(mIndices.available(current_head, 1) == 0) {
+        return false;
+    }
+    item = mArray[index(current_head)];
+    return true;
+}
+
+template<typename T, size_t SIZE>
+void SharedCircularQueue<T, SIZE>::copyIn(std::uint64_t tail, const T *items, size_t count) {
+    const size_t first = index(tail);
+    const size_t firstRun = std::min(count, SIZE - first);
+    std::memcpy(mArray + first, items, firstRun * sizeof(T));
+    std::memcpy(mArray, items + firstRun, (count - firstRun) * sizeof(T));
+}
+
+template<typename T, size_t SIZE>
+void SharedCircularQueue<T, SIZE>::copyOut(std::uint64_t head, T *items, size_t count) const {
+    const size_t first = index(head);
+    const size_t firstRun = std::min(count, SIZE - first);
+    std::memcpy(items, mArray + first, firstRun * sizeof(T));
+    std::memcpy(items + firstRun, mArray, (count - firstRun) * sizeof(T));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/**
+ * A mapped POSIX shared memory object (shm_open + mmap), unmapped on destruction.  The object itself persists until
+ * unlink() is called, so a producer and a consumer process can each open it by name.
+ */
+class SharedMemorySegment {
+public:
+    /**
+     * @param name - shared memory object name, e.g. "/my-queue".
+     * @param bytes - size of the mapping; the object is grown to this size if it's smaller.
+     * @param create - create the object if it doesn't exist yet.
+     */
+    SharedMemorySegment(const char *name, size_t bytes, bool create): mSize(bytes) {
+        const int fd = shm_open(name, O_RDWR | (create ? O_CREAT : 0), 0600);
+        if(fd < 0) {
+            throw std::system_error(errno, std::generic_category(), std::string("shm_open ") + name);
+        }
+        struct stat status{};
+        if(fstat(fd, &status) != 0 || ((size_t)status.st_size < bytes && ftruncate(fd, (off_t)bytes) != 0)) {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "sizing shared memory");
+        }
+        mData = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int error = errno;
+        close(fd);
+        if(mData == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+    }
+
+    ~SharedMemorySegment() { munmap(mData, mSize); }
+
+    SharedMemorySegment(const SharedMemorySegment &) = delete;
+    SharedMemorySegment &operator=(const SharedMemorySegment &) = delete;
+
+    [[nodiscard]] void *data() const { return mData; }
+    [[nodiscard]] size_t size() const { return mSize; }
+
+    static void unlink(const char *name) { shm_unlink(name); }
+
+private:
+    void *mData;
+    size_t mSize;
+};
+
+#endif //defined(__unix__) || defined(__APPLE__)
+
+#endif //STATICCOLLECTIONS_SHAREDCIRCULARQUEUE_H
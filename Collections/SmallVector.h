@@ -0,0 +1,236 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_SMALLVECTOR_H
+#define STATICCOLLECTIONS_SMALLVECTOR_H
+
+#include <cstddef>
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "Vector.h"
+
+/**
+ * Vector that keeps up to N elements inline, like a StaticVector<T, N>, and when it needs more moves them to a buffer
+ * from a memory resource, doubling the capacity each time.  Size N for the common case and the outliers cost a
+ * buffer from the resource instead of every vector being sized for the worst case.  The resource is any
+ * std::pmr::memory_resource, e.g. a std::pmr::monotonic_buffer_resource arena that is released all at once, and must
+ * outlive the vector; the default is the default resource (new/delete).  Once spilled the vector keeps its buffer
+ * until it is destroyed, clear() included.
+ *
+ * The growing functions hide Vector's rather than override them, since Vector has no virtual functions: through a
+ * Vector<T>& a SmallVector is a vector of its current capacity() whose push_back returns false when full.
+ */
+template <class T, size_t N>
+class SmallVector final: public Vector<T> {
+    static_assert(N > 0, "SmallVector needs room for at least one inline element.");
+
+private:
+    alignas(T) std::byte mInline[N * sizeof(T)];
+    std::pmr::memory_resource *mResource;
+
+    T* inlineStorage() { return reinterpret_cast<T*>(mInline); }
+
+public:
+    explicit SmallVector(std::pmr::memory_resource &resource = *std::pmr::get_default_resource()):
+            Vector<T>(uninitializedStorage, reinterpret_cast<T*>(mInline), N), mResource(&resource) {}
+
+    SmallVector(std::pmr::memory_resource &resource, const std::initializer_list<T> &initializerList):
+            SmallVector(resource) {
+        append(std::span<const T>(initializerList.begin(), initializerList.size()));
+    }
+    SmallVector(const std::initializer_list<T> &initializerList):
+            SmallVector(*std::pmr::get_default_resource(), initializerList) {}
+
+    // The copy allocates from the same resource as other.
+    SmallVector(const SmallVector &other): SmallVector(*other.mResource) {
+        append(std::span<const T>(other.data(), other.size()));
+    }
+    // Takes over other's buffer if it has spilled, otherwise moves the inline elements across; leaves other empty.
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>): SmallVector(*other.mResource) {
+        takeFrom(other);
+    }
+    SmallVector &operator=(const SmallVector &other) {
+        if(this != &other) {
+            this->clear();
+            append(std::span<const T>(other.data(), other.size()));
+        }
+        return *this;
+    }
+    // Keeps this vector's resource; other's buffer is only taken over if it came from an equal one.  Not noexcept,
+    // unlike the move constructor: from an unequal resource the elements are moved into a buffer allocated from this
+    // one, which can throw (as with std::pmr::vector).
+    SmallVector &operator=(SmallVector &&other) {
+        if(this != &other) {
+            this->clear();
+            if(other.isInline() || *mResource == *other.mResource) {
+                release();
+                takeFrom(other);
+            } else {
+                reserve(other.size());
+                this->moveIn(other.mDataPtr, other.size());
+                other.clear();
+            }
+        }
+        return *this;
+    }
+    ~SmallVector() {
+        this->clear();
+        release();
+    }
+
+    bool push_back(const T& elem) { return emplace_back(elem); }
+    bool push_back(T&& elem) { return emplace_back(std::move(elem)); }
+
+    /**
+     * Constructs an element in place at the end, moving to a larger buffer first if the vector is full.  args may
+     * refer to an element of this vector.
+     *
+     * @return true; an exhausted resource throws instead (std::bad_alloc from the default one).
+     */
+    template<typename... ARGS>
+    bool emplace_back(ARGS&&... args) {
+        if(!this->full()) {
+            return Vector<T>::emplace_back(std::forward<ARGS>(args)...);
+        }
+        const size_t capacity = grownCapacity(this->mCount + 1);
+        T* buffer = allocate(capacity);
+        try {
+            new(buffer + this->mCount) T(std::forward<ARGS>(args)...);    // before the elements it may refer to move
+        } catch(...) {
+            deallocate(buffer, capacity);
+            throw;
+        }
+        adopt(buffer, capacity);
+        this->mCount++;
+        return true;
+    }
+
+    template<typename... ARGS>
+    bool emplace(typename Vector<T>::const_iterator pos, ARGS&&... args) {
+        if(!this->full()) {
+            return Vector<T>::emplace(pos, std::forward<ARGS>(args)...);
+        }
+        const size_t index = this->indexOf(pos);   // before growing invalidates pos
+        T value(std::forward<ARGS>(args)...);
+        grow(this->mCount + 1);
+        return Vector<T>::emplace(this->begin() + index, std::move(value));
+    }
+    bool insert(typename Vector<T>::const_iterator pos, const T& elem) { return emplace(pos, elem); }
+    bool insert(typename Vector<T>::const_iterator pos, T&& elem) { return emplace(pos, std::move(elem)); }
+
+    // items must not refer to elements of this vector.
+    bool insert(typename Vector<T>::const_iterator pos, std::span<const T> items) {
+        const size_t index = this->indexOf(pos);
+        grow(this->mCount + items.size());
+        return Vector<T>::insert(this->begin() + index, items);
+    }
+
+    /**
+     * Copies items onto the end, growing once if they don't fit.  items may be this vector's own elements.
+     */
+    bool append(std::span<const T> items) {
+        const size_t count = items.size();
+        if(count <= this->mCapacity - this->mCount) {
+            return Vector<T>::append(items);
+        }
+        const size_t capacity = grownCapacity(this->mCount + count);
+        T* buffer = allocate(capacity);
+        try {
+            std::uninitialized_copy_n(items.data(), count, buffer + this->mCount);
+        } catch(...) {
+            deallocate(buffer, capacity);
+            throw;
+        }
+        adopt(buffer, capacity);
+        this->mCount += count;
+        return true;
+    }
+
+    bool resize(size_t count) {
+        grow(count);
+        return Vector<T>::resize(count);
+    }
+    bool resize(size_t count, const T& value) {
+        if(count <= this->mCapacity) {
+            return Vector<T>::resize(count, value);
+        }
+        const T copy(value);    // value may be an element, which grow() moves
+        grow(count);
+        return Vector<T>::resize(count, copy);
+    }
+
+    /**
+     * Moves the elements to a buffer of exactly capacity elements, if the current one is smaller.
+     */
+    void reserve(size_t capacity) {
+        if(capacity > this->mCapacity) {
+            adopt(allocate(capacity), capacity);
+        }
+    }
+
+    // Whether the elements are still in the inline buffer.
+    [[nodiscard]] bool isInline() const { return this->mDataPtr == reinterpret_cast<const T*>(mInline); }
+    [[nodiscard]] std::pmr::memory_resource &resource() const { return *mResource; }
+
+private:
+    size_t grownCapacity(size_t needed) const { return std::max(needed, 2 * this->mCapacity); }
+    void grow(size_t needed) {
+        if(needed > this->mCapacity) {
+            reserve(grownCapacity(needed));
+        }
+    }
+
+    T* allocate(size_t capacity) {
+        if(capacity > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::length_error("SmallVector capacity too large.");
+        }
+        return static_cast<T*>(mResource->allocate(capacity * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* buffer, size_t capacity) { mResource->deallocate(buffer, capacity * sizeof(T), alignof(T)); }
+
+    // Gives a spilled buffer back to the resource and points back at the (empty) inline buffer.
+    void release() {
+        if(!isInline()) {
+            deallocate(this->mDataPtr, this->mCapacity);
+            this->mDataPtr = inlineStorage();
+            this->mCapacity = N;
+        }
+    }
+
+    // Moves the elements into buffer, which holds capacity elements, and switches to it.
+    void adopt(T* buffer, size_t capacity) {
+        std::uninitialized_move_n(this->mDataPtr, this->mCount, buffer);
+        std::destroy_n(this->mDataPtr, this->mCount);
+        if(!isInline()) {
+            deallocate(this->mDataPtr, this->mCapacity);
+        }
+        this->mDataPtr = buffer;
+        this->mCapacity = capacity;
+    }
+
+    // Expects this vector to be empty and inline.
+    void takeFrom(SmallVector &other) {
+        if(other.isInline()) {
+            this->moveIn(other.inlineStorage(), other.size());
+            other.clear();
+        } else {
+            this->mDataPtr = other.mDataPtr;
+            this->mCapacity = other.mCapacity;
+            this->mCount = other.mCount;
+            other.mDataPtr = other.inlineStorage();
+            other.mCapacity = N;
+            other.mCount = 0;
+        }
+    }
+};
+
+#endif //STATICCOLLECTIONS_SMALLVECTOR_H
@@ -0,0 +1,80 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_STATICLATEST_H
+#define STATICCOLLECTIONS_STATICLATEST_H
+
+#include <cstdint>
+#include <atomic>
+#include <type_traits>
+#include "CacheLine.h"
+
+/**
+ * Single-writer/multi-reader "latest value wins" cell, guarded by a sequence counter (seqlock).  The writer makes the
+ * sequence odd, stores the value and makes it even again, so store() never waits.  A reader copies the value between
+ * two reads of the sequence and retries if the sequence was odd or changed, so it always returns a complete value and
+ * it is the newest one at the time of the copy.  Readers write nothing shared, so any number can read at once.
+ *
+ * T must be trivially copyable, since a reader may copy the value while the writer is overwriting it (the copy is
+ * then discarded).  Keep T small: a reader retries for as long as it keeps overlapping stores.  For larger values or
+ * types that aren't trivially copyable use StaticTripleBuffer.
+ */
+template<typename T>
+class StaticLatest {
+    static_assert(std::is_trivially_copyable_v<T>, "StaticLatest values must be trivially copyable.");
+
+public:
+    StaticLatest() = default;
+    explicit StaticLatest(const T &initial): mValue(initial) {}
+    StaticLatest(const StaticLatest &) = delete;
+    StaticLatest &operator=(const StaticLatest &) = delete;
+
+    /**
+     * Writer only.  Replaces the value.
+     */
+    void store(const T &value) {
+        const auto sequence = mSequence.load(std::memory_order_relaxed);
+        mSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mValue = value;
+        mSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * Copies the newest complete value into value.
+     *
+     * @return the number of store() calls that value reflects, so a reader can tell whether it has changed.
+     */
+    std::uint64_t load(T &value) const {
+        for(;;) {
+            const auto before = mSequence.load(std::memory_order_acquire);
+            if(before & 1) {
+                continue;   // store in progress
+            }
+            const T copy = mValue;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(mSequence.load(std::memory_order_relaxed) == before) {
+                value = copy;
+                return before / 2;
+            }
+        }
+    }
+
+    [[nodiscard]] T load() const {
+        T value;
+        load(value);
+        return value;
+    }
+
+    /**
+     * Number of store() calls so far, the same count load() returns.
+     */
+    [[nodiscard]] std::uint64_t version() const { return mSequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic_uint64_t mSequence{0};    // odd while a store is in progress
+    T mValue{};
+};
+
+#endif //STATICCOLLECTIONS_STATICLATEST_H
@@ -8,7 +8,7 @@
 #include "LinkedList.h"
 
 template<typename T, size_t NUM_ELEMS>
-class StaticLinkedList: public LinkedList<T> {
+class StaticLinkedList final: public LinkedList<T> {
 public:
     StaticLinkedList(): LinkedList<T>(mStaticAllocator) {}
 
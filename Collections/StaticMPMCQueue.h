@@ -0,0 +1,206 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_STATICMPMCQUEUE_H
+#define STATICCOLLECTIONS_STATICMPMCQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "CacheLine.h"
+#include "Queue.h"
+
+/**
+ * Bounded lock-free multi-producer/multi-consumer queue (Dmitry Vyukov's design).  Every slot carries a sequence
+ * number that tells producers and consumers whether the slot is free for position p (sequence == p) or holds the
+ * element for position p (sequence == p + 1).  Producers and consumers only contend on their own position counter,
+ * each on its own cache line, and never take a lock.
+ *
+ * SIZE must be a power of two.
+ */
+template<typename T, size_t SIZE>
+class StaticMPMCQueue final {
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "StaticMPMCQueue SIZE must be a power of two.");
+
+public:
+    typedef T value_type;
+    enum {CAPACITY = SIZE};
+
+    StaticMPMCQueue() { clear(); }
+    StaticMPMCQueue(const std::initializer_list<T> &initializerList) {
+        if(initializerList.size() > SIZE) {
+            throw std::runtime_error("number of initializer elements exceeds capacity.");
+        }
+
+        clear();
+        for(const T* elem = initializerList.begin(); elem != initializerList.end(); elem++) {
+            this->push(*elem);
+        }
+    }
+
+    // Not thread safe; no producer or consumer may be active.
+    void clear() {
+        for(size_t i = 0; i < SIZE; i++) {
+            mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+        mEnqueuePos.store(0, std::memory_order_relaxed);
+        mDequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    bool push(const T& item) { return emplace(item); }
+    bool push(T&& item) { return emplace(std::move(item)); }
+    bool push(const T* items, size_t count);
+    bool pop(T& item);
+    bool pop(T* items, size_t count);
+    bool popElements(size_t count);
+    bool peek(T& item);
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] bool full() const { return size() == SIZE; }
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+private:
+    struct Slot {
+        std::atomic_size_t mSequence;
+        T mValue{};
+    };
+
+    template<typename U>
+    bool emplace(U &&item);
+
+    // Claims count consecutive positions from position, whose slots must all have the sequence position + i + offset.
+    // Returns false if any slot is not ready (queue full/empty), otherwise the claimed first position is in position.
+    bool claim(std::atomic_size_t &position, size_t &first, size_t count, size_t offset);
+
+    static constexpr size_t MASK = SIZE - 1;
+
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t mEnqueuePos{0};
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t mDequeuePos{0};
+    alignas(CACHE_LINE_SIZE) Slot mSlots[SIZE];
+};
+
+template<typename T, size_t SIZE>
+template<typename U>
+bool StaticMPMCQueue<T, SIZE>::emplace(U &&item) {
+    size_t pos;
+    if(!claim(mEnqueuePos, pos, 1, 0)) {
+        return false;  // full queue
+    }
+    Slot &slot = mSlots[pos & MASK];
+    slot.mValue = std::forward<U>(item);
+    slot.mSequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+// All or nothing: the positions for every item are claimed with a single CAS, so the items are also contiguous in
+// the queue order.
+template<typename T, size_t SIZE>
+bool StaticMPMCQueue<T, SIZE>::push(const T *items, size_t count) {
+    if(!items || count > SIZE) {
+        return false;
+    }
+    size_t pos;
+    if(!claim(mEnqueuePos, pos, count, 0)) {
+        return false;
+    }
+    for(size_t i = 0; i < count; i++) {
+        Slot &slot = mSlots[(pos + i) & MASK];
+        slot.mValue = items[i];
+        slot.mSequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+template<typename T, size_t SIZE>
+bool StaticMPMCQueue<T, SIZE>::pop(T &item) {
+    size_t pos;
+    if(!claim(mDequeuePos, pos, 1, 1)) {
+        return false;  // empty queue
+    }
+    Slot &slot = mSlots[pos & MASK];
+    item = std::move(slot.mValue);
+    slot.mSequence.store(pos + SIZE, std::memory_order_release);
+    return true;
+}
+
+// All or nothing, see push(const T*, size_t).
+template<typename T, size_t SIZE>
+bool StaticMPMCQueue<T, SIZE>::pop(T *items, size_t count) {
+    if(!items || count > SIZE) {
+        return false;
+    }
+    size_t pos;
+    if(!claim(mDequeuePos, pos, count, 1)) {
+        return false;
+    }
+    for(size_t i = 0; i < count; i++) {
+        Slot &slot = mSlots[(pos + i) & MASK];
+        items[i] = std::move(slot.mValue);
+        slot.mSequence.store(pos + i + SIZE, std::memory_order_release);
+    }
+    return true;
+}
+
+// Pops and discards up to count elements.
+template<typename T, size_t SIZE>
+bool StaticMPMCQueue<T, SIZE>::popElements(size_t count) {
+    T discard;
+    while(count-- && pop(discard)) {
+    }
+    return true;
+}
+
+// Only meaningful with a single consumer: another consumer may pop, and a producer refill, the front element while
+// it is being copied.
+template<typename T, size_t SIZE>
+bool StaticMPMCQueue<T, SIZE>::peek(T &item) {
+    const size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+    const Slot &slot = mSlots[pos & MASK];
+    if(slot.mSequence.load(std::memory_order_acquire) != pos + 1) {
+        return false;  // empty queue
+    }
+    item = slot.mValue;
+    return true;
+}
+
+// snapshot with acceptance that this is not atomic with respect to concurrent producers and consumers
+template<typename T, size_t SIZE>
+size_t StaticMPMCQueue<T, SIZE>::size() const {
+    const size_t dequeuePos = mDequeuePos.load(std::memory_order_acquire);
+    const size_t enqueuePos = mEnqueuePos.load(std::memory_order_acquire);
+    return enqueuePos > dequeuePos ? std::min<size_t>(enqueuePos - dequeuePos, SIZE) : 0;
+}
+
+template<typename T, size_t SIZE>
+bool StaticMPMCQueue<T, SIZE>::claim(std::atomic_size_t &position, size_t &first, size_t count, size_t offset) {
+    size_t pos = position.load(std::memory_order_relaxed);
+    for(;;) {
+        bool stale = false;
+        for(size_t i = 0; i < count; i++) {
+            const size_t seq = mSlots[(pos + i) & MASK].mSequence.load(std::memory_order_acquire);
+            const auto diff = (intptr_t)seq - (intptr_t)(pos + i + offset);
+            if(diff < 0) {
+                return false;   // slot still owned by the other side
+            }
+            if(diff > 0) {
+                stale = true;   // another thread already claimed this position
+                break;
+            }
+        }
+
+        if(stale) {
+            pos = position.load(std::memory_order_relaxed);
+        } else if(position.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+            first = pos;
+            return true;
+        }
+    }
+}
+
+#endif //STATICCOLLECTIONS_STATICMPMCQUEUE_H
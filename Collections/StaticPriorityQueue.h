@@ -0,0 +1,343 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_STATICPRIORITYQUEUE_H
+#define STATICCOLLECTIONS_STATICPRIORITYQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include "Queue.h"
+
+/**
+ * Fixed capacity priority queue with all storage inline.  Like std::priority_queue, the front of the queue is the
+ * element that no other element compares greater than: Compare = std::less<T> gives the largest element first,
+ * std::greater<T> the smallest (e.g. the next deadline).
+ *
+ * The elements are kept in a 4-ary heap: the four children of a node are adjacent in memory, so choosing the child
+ * to sift down to usually touches a single cache line (a group can straddle two, since groups start at 4p + 1 and
+ * the heap isn't padded to line boundaries), and the heap is half as deep as a binary heap.
+ *
+ * Every element pushed gets a Handle that stays valid, wherever the element moves in the heap, until the element is
+ * popped or erased.  The handle can be used to change the element's key (e.g. decrease-key) or remove it in
+ * O(log n).  Handles carry a generation count, so a stale handle is detected rather than aliasing a newer element.
+ */
+template<typename T, size_t SIZE, typename Compare = std::less<T>>
+class StaticPriorityQueue final {
+    static_assert(SIZE > 0 && SIZE < std::numeric_limits<std::uint32_t>::max(), "StaticPriorityQueue SIZE out of range.");
+
+public:
+    typedef T value_type;
+    enum {CAPACITY = SIZE};
+
+    struct Handle {
+        std::uint32_t mIndex{std::numeric_limits<std::uint32_t>::max()};
+        std::uint32_t mGeneration{0};
+
+        bool operator==(const Handle &rhs) const = default;
+    };
+
+    explicit StaticPriorityQueue(const Compare &compare = Compare()): mCompare(compare) { initHandles(); }
+    StaticPriorityQueue(const std::initializer_list<T> &initializerList, const Compare &compare = Compare()):
+            mCompare(compare) {
+        if(initializerList.size() > SIZE) {
+            throw std::runtime_error("number of initializer elements exceeds capacity.");
+        }
+
+        initHandles();
+        push(initializerList.begin(), initializerList.size());
+    }
+
+    void clear();
+    bool push(const T& item) { Handle handle; return push(item, handle); }
+
+    /**
+     * Pushes item and returns its handle in handle.
+     */
+    bool push(const T& item, Handle &handle);
+
+    /**
+     * All or nothing bulk push.  When the batch is at least as large as the queue already is, the items are appended
+     * and the whole heap is rebuilt in O(n) (Floyd's heapify) instead of sifting each item up.
+     */
+    bool push(const T* items, size_t count);
+    bool pop(T& item);
+
+    /**
+     * All or nothing: pops count elements, in priority order, into items.
+     */
+    bool pop(T* items, size_t count);
+    bool popElements(size_t count);
+    bool peek(T& item);
+
+    [[nodiscard]] bool empty() const { return mSize == 0; }
+    [[nodiscard]] bool full() const { return mSize == SIZE; }
+    [[nodiscard]] size_t size() const { return mSize; }
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+    /**
+     * @throws std::underflow_error if the queue is empty.
+     */
+    const T &top() const {
+        if(empty()) {
+            throw std::underflow_error("StaticPriorityQueue is empty");
+        }
+        return mHeap[0];
+    }
+
+    /**
+     * @return true if handle refers to an element still in the queue.
+     */
+    [[nodiscard]] bool contains(Handle handle) const {
+        return handle.mIndex < SIZE && mGeneration[handle.mIndex] == handle.mGeneration &&
+               mPosition[handle.mIndex] != NOT_QUEUED;
+    }
+
+    /**
+     * @throws std::invalid_argument if handle isn't in the queue.
+     */
+    const T &get(Handle handle) const {
+        checkHandle(handle);
+        return mHeap[mPosition[handle.mIndex]];
+    }
+
+    /**
+     * Replaces the element referred to by handle with value and restores the heap order, moving the element towards
+     * the front (decrease-key in a min queue) or the back as needed.  The handle stays valid.
+     *
+     * @throws std::invalid_argument if handle isn't in the queue.
+     */
+    void updateKey(Handle handle, const T& value);
+
+    /**
+     * Removes the element referred to by handle.
+     *
+     * @return false if handle isn't in the queue.
+     */
+    bool erase(Handle handle);
+
+private:
+    static constexpr size_t ARITY = 4;
+    static constexpr std::uint32_t NOT_QUEUED = std::numeric_limits<std::uint32_t>::max();
+
+    static size_t parent(size_t pos) { return (pos - 1) / ARITY; }
+    static size_t firstChild(size_t pos) { return pos * ARITY + 1; }
+
+    void initHandles();
+    Handle allocateHandle(size_t pos);
+    void releaseHandle(std::uint32_t index);
+    void checkHandle(Handle handle) const {
+        if(!contains(handle)) {
+            throw std::invalid_argument("StaticPriorityQueue handle is not in the queue.");
+        }
+    }
+
+    // Stores value at heap position dest, keeping the handle table in step.
+    void place(size_t dest, T &&value, std::uint32_t handleIndex) {
+        mHeap[dest] = std::move(value);
+        mHandleAt[dest] = handleIndex;
+        mPosition[handleIndex] = (std::uint32_t)dest;
+    }
+    void siftUp(size_t pos);
+    void siftDown(size_t pos);
+    void removeAt(size_t pos);
+
+    Compare         mCompare;
+    size_t          mSize{0};
+    T               mHeap[SIZE]{};
+    std::uint32_t   mHandleAt[SIZE]{};          // handle index of the element at each heap position
+    std::uint32_t   mPosition[SIZE]{};          // heap position of each handle index, NOT_QUEUED if free
+    std::uint32_t   mGeneration[SIZE]{};        // bumped each time a handle index is released
+    std::uint32_t   mFreeHandles[SIZE]{};       // stack of free handle indexes; SIZE - mSize entries
+};
+
+template<typename T, size_t SIZE, typename Compare>
+void StaticPriorityQueue<T, SIZE, Compare>::initHandles() {
+    for(size_t i = 0; i < SIZE; i++) {
+        mPosition[i] = NOT_QUEUED;
+        mFreeHandles[i] = (std::uint32_t)(SIZE - 1 - i);
+    }
+}
+
+template<typename T, size_t SIZE, typename Compare>
+void StaticPriorityQueue<T, SIZE, Compare>::clear() {
+    while(mSize) {
+        releaseHandle(mHandleAt[--mSize]);
+    }
+}
+
+template<typename T, size_t SIZE, typename Compare>
+typename StaticPriorityQueue<T, SIZE, Compare>::Handle StaticPriorityQueue<T, SIZE, Compare>::allocateHandle(size_t pos) {
+    const std::uint32_t index = mFreeHandles[SIZE - 1 - mSize];
+    mHandleAt[pos] = index;
+    mPosition[index] = (std::uint32_t)pos;
+    return {index, mGeneration[index]};
+}
+
+template<typename T, size_t SIZE, typename Compare>
+void StaticPriorityQueue<T, SIZE, Compare>::releaseHandle(std::uint32_t index) {
+    mPosition[index] = NOT_QUEUED;
+    mGeneration[index]++;
+    mFreeHandles[SIZE - 1 - mSize] = index;
+}
+
+template<typename T, size_t SIZE, typename Compare>
+bool StaticPriorityQueue<T, SIZE, Compare>::push(const T &item, Handle &handle) {
+    if(full()) {
+        return false;
+    }
+    mHeap[mSize] = item;
+    handle = allocateHandle(mSize);
+    siftUp(mSize++);
+    return true;
+}
+
+template<typename T, size_t SIZE, typename Compare>
+bool StaticPriorityQueue<T, SIZE, Compare>::push(const T *items, size_t count) {
+    if(!items || count > SIZE - mSize) {
+        return false;
+    }
+    if(count < mSize) {
+        for(size_t i = 0; i < count; i++) {
+            Handle handle;
+            push(items[i], handle);
+        }
+        return true;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        mHeap[mSize] = items[i];
+        allocateHandle(mSize);
+        mSize++;
+    }
+    if(mSize > 1) {
+        for(size_t pos = parent(mSize - 1) + 1; pos-- > 0;) {
+            siftDown(pos);
+        }
+    }
+    return true;
+}
+
+template<typename T, size_t SIZE, typename Compare>
+bool StaticPriorityQueue<T, SIZE, Compare>::pop(T &item) {
+    if(empty()) {
+        return false;
+    }
+    item = std::move(mHeap[0]);
+    removeAt(0);
+    return true;
+}
+
+template<typename T, size_t SIZE, typename Compare>
+bool StaticPriorityQueue<T, SIZE, Compare>::pop(T *items, size_t count) {
+    if(!items || count > mSize) {
+        return false;
+    }
+    for(size_t i = 0; i < count; i++) {
+        pop(items[i]);
+    }
+    return true;
+}
+
+template<typename T, size_t SIZE, typename Compare>
+bool StaticPriorityQueue<T, SIZE, Compare>::popElements(size_t count) {
+    while(count-- && !empty()) {
+        removeAt(0);
+    }
+    return true;
+}
+
+template<typename T, size_t SIZE, typename Compare>
+bool StaticPriorityQueue<T, SIZE, Compare>::peek(T &item) {
+    if(empty()) {
+        return false;
+    }
+    item = mHeap[0];
+    return true;
+}
+
+template<typename T, size_t SIZE, typename Compare>
+void StaticPriorityQueue<T, SIZE, Compare>::updateKey(Handle handle, const T &value) {
+    checkHandle(handle);
+    const size_t pos = mPosition[handle.mIndex];
+    mHeap[pos] = value;
+    if(pos > 0 && mCompare(mHeap[parent(pos)], mHeap[pos])) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+template<typename T, size_t SIZE, typename Compare>
+bool StaticPriorityQueue<T, SIZE, Compare>::erase(Handle handle) {
+    if(!contains(handle)) {
+        return false;
+    }
+    removeAt(mPosition[handle.mIndex]);
+    return true;
+}
+
+// Removes the element at pos by moving the last element into its place and sifting that in whichever direction
+// restores the heap order.
+template<typename T, size_t SIZE, typename Compare>
+void StaticPriorityQueue<T, SIZE, Compare>::removeAt(size_t pos) {
+    const std::uint32_t removed = mHandleAt[pos];
+    const size_t last = --mSize;
+    if(pos != last) {
+        place(pos, std::move(mHeap[last]), mHandleAt[last]);
+        if(pos > 0 && mCompare(mHeap[parent(pos)], mHeap[pos])) {
+            siftUp(pos);
+        } else {
+            siftDown(pos);
+        }
+    }
+    releaseHandle(removed);
+}
+
+template<typename T, size_t SIZE, typename Compare>
+void StaticPriorityQueue<T, SIZE, Compare>::siftUp(size_t pos) {
+    T value = std::move(mHeap[pos]);
+    const std::uint32_t handleIndex = mHandleAt[pos];
+    while(pos > 0) {
+        const size_t up = parent(pos);
+        if(!mCompare(mHeap[up], value)) {
+            break;
+        }
+        place(pos, std::move(mHeap[up]), mHandleAt[up]);
+        pos = up;
+    }
+    place(pos, std::move(value), handleIndex);
+}
+
+template<typename T, size_t SIZE, typename Compare>
+void StaticPriorityQueue<T, SIZE, Compare>::siftDown(size_t pos) {
+    T value = std::move(mHeap[pos]);
+    const std::uint32_t handleIndex = mHandleAt[pos];
+    for(;;) {
+        const size_t first = firstChild(pos);
+        if(first >= mSize) {
+            break;
+        }
+        const size_t end = std::min(first + ARITY, mSize);
+        size_t best = first;
+        for(size_t child = first + 1; child < end; child++) {
+            if(mCompare(mHeap[best], mHeap[child])) {
+                best = child;
+            }
+        }
+        if(!mCompare(value, mHeap[best])) {
+            break;
+        }
+        place(pos, std::move(mHeap[best]), mHandleAt[best]);
+        pos = best;
+    }
+    place(pos, std::move(value), handleIndex);
+}
+
+#endif //STATICCOLLECTIONS_STATICPRIORITYQUEUE_H
@@ -0,0 +1,289 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_STATICSOAVECTOR_H
+#define STATICCOLLECTIONS_STATICSOAVECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "CacheLine.h"
+
+/**
+ * Fixed capacity vector of SIZE records with the given FIELDS, stored as a structure of arrays: each field has its own
+ * contiguous array, aligned to a cache line.  A loop that reads one or two fields of every record then streams
+ * through only those arrays, every byte it loads is one it uses, and column<I>() hands the array to a SIMD kernel
+ * (e.g. VectorScan) as a std::span.
+ *
+ * The row API follows StaticVector.  A row is a proxy: operator[], front(), back() and the iterators yield a
+ * std::tuple of references to the row's fields, which can be assigned a tuple of values, read with std::get or
+ * decomposed with a structured binding (auto [x, y] = soa[i] binds references).  As in StaticVector the arrays are raw
+ * storage and only the size() rows in use are constructed.
+ */
+template <size_t SIZE, typename... FIELDS>
+class StaticSoAVector final {
+    static_assert(sizeof...(FIELDS) > 0, "StaticSoAVector needs at least one field.");
+
+public:
+    typedef std::tuple<FIELDS...>             value_type;
+    typedef std::tuple<FIELDS&...>            reference;
+    typedef std::tuple<const FIELDS&...>      const_reference;
+    typedef size_t                            size_type;
+    typedef ptrdiff_t                         difference_type;
+
+    template<size_t I>
+    using Field = std::tuple_element_t<I, value_type>;
+
+    template<bool CONST>
+    class Iterator;
+    typedef Iterator<false>                   iterator;
+    typedef Iterator<true>                    const_iterator;
+
+    StaticSoAVector() = default;
+    StaticSoAVector(const StaticSoAVector &other) { copyIn(other); }
+    // Moves the rows across and leaves other empty.
+    StaticSoAVector(StaticSoAVector &&other) noexcept((std::is_nothrow_move_constructible_v<FIELDS> && ...)) {
+        moveIn(other);
+    }
+    StaticSoAVector(const std::initializer_list<value_type> &initializerList) {
+        if(initializerList.size() > SIZE) {
+            throw std::runtime_error("number of initializer elements exceeds capacity.");
+        }
+        for(const auto &row: initializerList) {
+            push_back(row);
+        }
+    }
+    StaticSoAVector &operator=(const StaticSoAVector &other) {
+        if(this != &other) {
+            clear();
+            copyIn(other);
+        }
+        return *this;
+    }
+    StaticSoAVector &operator=(StaticSoAVector &&other)
+            noexcept((std::is_nothrow_move_constructible_v<FIELDS> && ...)) {
+        if(this != &other) {
+            clear();
+            moveIn(other);
+        }
+        return *this;
+    }
+    ~StaticSoAVector() { clear(); }
+
+    bool push_back(const value_type &row) { return pushRow(row); }
+    bool push_back(value_type &&row) { return pushRow(std::move(row)); }
+
+    /**
+     * Constructs a row at the end, each field from the matching argument.
+     *
+     * @return false, without constructing anything, if the vector is full.
+     */
+    template<typename... ARGS> requires (sizeof...(ARGS) == sizeof...(FIELDS))
+    bool emplace_back(ARGS&&... args) { return pushRow(std::forward_as_tuple(std::forward<ARGS>(args)...)); }
+
+    void pop_back() {
+        if(mCount > 0) {
+            mCount--;
+            forEachField([this]<size_t I>(std::integral_constant<size_t, I>) {
+                std::destroy_at(columnData<I>() + mCount);
+            });
+        }
+    }
+    void clear() {
+        forEachField([this]<size_t I>(std::integral_constant<size_t, I>) {
+            std::destroy_n(columnData<I>(), mCount);
+        });
+        mCount = 0;
+    }
+
+    [[nodiscard]] size_t size() const { return mCount; }
+    [[nodiscard]] size_t capacity() const { return SIZE; }
+    [[nodiscard]] bool empty() const { return mCount == 0; }
+    [[nodiscard]] bool full() const { return mCount == SIZE; }
+
+    /**
+     * The size() values of field I, contiguous and aligned to a cache line.
+     */
+    template<size_t I>
+    std::span<Field<I>> column() { return {columnData<I>(), mCount}; }
+    template<size_t I>
+    std::span<const Field<I>> column() const { return {columnData<I>(), mCount}; }
+
+    reference operator[](int index) { return row(checked(index)); }
+    const_reference operator[](int index) const { return row(checked(index)); }
+    reference front() {
+        if(empty()) { throw std::range_error("front() called on empty vector"); }
+        return row(0);
+    }
+    reference back() {
+        if(empty()) { throw std::range_error("back() called on empty vector"); }
+        return row(mCount - 1);
+    }
+    const_reference front() const {
+        if(empty()) { throw std::range_error("front() called on empty vector"); }
+        return row(0);
+    }
+    const_reference back() const {
+        if(empty()) { throw std::range_error("back() called on empty vector"); }
+        return row(mCount - 1);
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    iterator end() { return iterator(this, mCount); }
+    const_iterator end() const { return const_iterator(this, mCount); }
+
+    /**
+     * Random access iterator over rows.  Dereferencing yields a reference/const_reference proxy by value, so
+     * algorithms that only read rows or assign whole rows work, but ones that swap them (std::sort, std::reverse)
+     * need a standard library whose std::tuple of references is swappable as an rvalue (C++23).
+     */
+    template<bool CONST>
+    class Iterator {
+    public:
+        typedef std::random_access_iterator_tag                                     iterator_category;
+        typedef StaticSoAVector::value_type                                         value_type;
+        typedef StaticSoAVector::difference_type                                    difference_type;
+        typedef std::conditional_t<CONST, StaticSoAVector::const_reference,
+                                   StaticSoAVector::reference>                      reference;
+        typedef void                                                                pointer;
+
+        Iterator() = default;
+        Iterator(std::conditional_t<CONST, const StaticSoAVector, StaticSoAVector> *vector, size_t index):
+                mVector(vector), mIndex(index) {}
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        operator Iterator<true>() const requires (!CONST) { return {mVector, mIndex}; }
+
+        reference operator*() const { return mVector->row(mIndex); }
+        reference operator[](difference_type n) const { return mVector->row(mIndex + n); }
+
+        Iterator &operator++() { mIndex++; return *this; }
+        Iterator operator++(int) { Iterator old = *this; mIndex++; return old; }
+        Iterator &operator--() { mIndex--; return *this; }
+        Iterator operator--(int) { Iterator old = *this; mIndex--; return old; }
+        Iterator &operator+=(difference_type n) { mIndex += n; return *this; }
+        Iterator &operator-=(difference_type n) { mIndex -= n; return *this; }
+        Iterator operator+(difference_type n) const { return {mVector, mIndex + n}; }
+        friend Iterator operator+(difference_type n, const Iterator &it) { return it + n; }
+        Iterator operator-(difference_type n) const { return {mVector, mIndex - n}; }
+        difference_type operator-(const Iterator &other) const {
+            return static_cast<difference_type>(mIndex) - static_cast<difference_type>(other.mIndex);
+        }
+        bool operator==(const Iterator &other) const { return mIndex == other.mIndex; }
+        auto operator<=>(const Iterator &other) const { return mIndex <=> other.mIndex; }
+
+    private:
+        std::conditional_t<CONST, const StaticSoAVector, StaticSoAVector> *mVector = nullptr;
+        size_t mIndex = 0;
+    };
+
+private:
+    template<typename F>
+    struct alignas(std::max(alignof(F), CACHE_LINE_SIZE)) Column {
+        std::byte mStorage[SIZE * sizeof(F)];
+    };
+
+    std::tuple<Column<FIELDS>...> mColumns;
+    size_t mCount{0};
+
+    template<size_t I>
+    Field<I>* columnData() { return reinterpret_cast<Field<I>*>(std::get<I>(mColumns).mStorage); }
+    template<size_t I>
+    const Field<I>* columnData() const { return reinterpret_cast<const Field<I>*>(std::get<I>(mColumns).mStorage); }
+
+    template<typename FN>
+    static void forEachField(FN &&fn) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (fn(std::integral_constant<size_t, I>{}), ...);
+        }(std::index_sequence_for<FIELDS...>{});
+    }
+
+    size_t checked(int index) const {
+        if(index < 0 || static_cast<size_t>(index) >= mCount) {
+            throw std::out_of_range("Index out of range!");
+        }
+        return static_cast<size_t>(index);
+    }
+
+    reference row(size_t index) {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return reference(columnData<I>()[index]...);
+        }(std::index_sequence_for<FIELDS...>{});
+    }
+    const_reference row(size_t index) const {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return const_reference(columnData<I>()[index]...);
+        }(std::index_sequence_for<FIELDS...>{});
+    }
+
+    // Constructs field I onwards of row index from the matching elements of values.  If one throws, those already
+    // constructed are destroyed, so a row is either complete or absent.
+    template<size_t I = 0, typename TUPLE>
+    void constructRow(size_t index, TUPLE &&values) {
+        if constexpr(I < sizeof...(FIELDS)) {
+            new(columnData<I>() + index) Field<I>(std::get<I>(std::forward<TUPLE>(values)));
+            try {
+                constructRow<I + 1>(index, std::forward<TUPLE>(values));
+            } catch(...) {
+                std::destroy_at(columnData<I>() + index);
+                throw;
+            }
+        }
+    }
+
+    template<typename TUPLE>
+    bool pushRow(TUPLE &&values) {
+        if(mCount < SIZE) {
+            constructRow(mCount, std::forward<TUPLE>(values));
+            mCount++;
+            return true;
+        }
+        return false;
+    }
+
+    // Copy/move the rows of other into this empty vector, a column at a time with memcpy when every field is
+    // trivially copyable.
+    void copyIn(const StaticSoAVector &other) {
+        if constexpr((std::is_trivially_copyable_v<FIELDS> && ...)) {
+            copyColumns(other);
+        } else {
+            for(size_t i = 0; i < other.mCount; i++) {
+                pushRow(other.row(i));
+            }
+        }
+    }
+    void moveIn(StaticSoAVector &other) {
+        if constexpr((std::is_trivially_copyable_v<FIELDS> && ...)) {
+            copyColumns(other);
+        } else {
+            for(size_t i = 0; i < other.mCount; i++) {
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    pushRow(std::forward_as_tuple(std::move(other.template columnData<I>()[i])...));
+                }(std::index_sequence_for<FIELDS...>{});
+            }
+        }
+        other.clear();
+    }
+    void copyColumns(const StaticSoAVector &other) {
+        forEachField([&]<size_t I>(std::integral_constant<size_t, I>) {
+            if(other.mCount > 0) {
+                std::memcpy(static_cast<void*>(columnData<I>()), other.template columnData<I>(),
+                            other.mCount * sizeof(Field<I>));
+            }
+        });
+        mCount = other.mCount;
+    }
+};
+
+#endif //STATICCOLLECTIONS_STATICSOAVECTOR_H
@@ -0,0 +1,295 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_STATICTHREADPOOL_H
+#define STATICCOLLECTIONS_STATICTHREADPOOL_H
+
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "BlockingCircularQueue.h"
+
+/**
+ * Type erased void() callable stored in a fixed BUFFER_SIZE byte buffer, never on the heap.  A callable that doesn't
+ * fit, or that could throw while being moved, is rejected at compile time.  Move-only, like the callables it holds.
+ */
+template<size_t BUFFER_SIZE>
+class StaticTask {
+public:
+    StaticTask() = default;
+
+    template<typename FN, typename = std::enable_if_t<!std::is_same_v<std::decay_t<FN>, StaticTask>>>
+    StaticTask(FN &&fn) {    // NOLINT(google-explicit-constructor)
+        using Callable = std::decay_t<FN>;
+        static_assert(sizeof(Callable) <= BUFFER_SIZE, "callable is too large for the StaticTask buffer.");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "callable is over-aligned for StaticTask.");
+        static_assert(std::is_nothrow_move_constructible_v<Callable>, "StaticTask callables must be nothrow movable.");
+        new(mBuffer) Callable(std::forward<FN>(fn));
+        mOps = &OPS<Callable>;
+    }
+
+    StaticTask(StaticTask &&other) noexcept { moveFrom(other); }
+    StaticTask &operator=(StaticTask &&other) noexcept {
+        if(this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+    StaticTask(const StaticTask &) = delete;
+    StaticTask &operator=(const StaticTask &) = delete;
+    ~StaticTask() { reset(); }
+
+    explicit operator bool() const { return mOps != nullptr; }
+    void operator()() { mOps->invoke(mBuffer); }
+
+private:
+    struct Ops {
+        void (*invoke)(void *);
+        void (*move)(void *dst, void *src);     // move constructs into dst and destroys src
+        void (*destroy)(void *);
+    };
+
+    template<typename Callable>
+    static constexpr Ops OPS{
+        [](void *fn) { (*static_cast<Callable *>(fn))(); },
+        [](void *dst, void *src) {
+            new(dst) Callable(std::move(*static_cast<Callable *>(src)));
+            static_cast<Callable *>(src)->~Callable();
+        },
+        [](void *fn) { static_cast<Callable *>(fn)->~Callable(); }
+    };
+
+    void moveFrom(StaticTask &other) {
+        if(other.mOps) {
+            other.mOps->move(mBuffer, other.mBuffer);
+            mOps = std::exchange(other.mOps, nullptr);
+        }
+    }
+
+    void reset() {
+        if(mOps) {
+            std::exchange(mOps, nullptr)->destroy(mBuffer);
+        }
+    }
+
+    alignas(std::max_align_t) std::byte mBuffer[BUFFER_SIZE];
+    const Ops *mOps{nullptr};
+};
+
+/**
+ * Countdown like std::latch whose wait() also waits for the final countDown() to finish notifying, so the waiter may
+ * destroy the latch (e.g. a stack object) as soon as wait() returns without the notifying thread touching freed
+ * memory.  The notifier's last access is the release store of mNotified, which the waiter spins on briefly.
+ */
+class TaskLatch {
+public:
+    explicit TaskLatch(size_t count): mCount(count), mNotified(count == 0) {}
+    TaskLatch(const TaskLatch &) = delete;
+    TaskLatch &operator=(const TaskLatch &) = delete;
+
+    void countDown() noexcept {
+        if(mCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            mCount.notify_all();
+            mNotified.store(true, std::memory_order_release);   // last access to *this
+        }
+    }
+
+    [[nodiscard]] bool tryWait() const { return mNotified.load(std::memory_order_acquire); }
+
+    void wait() const {
+        for(auto left = mCount.load(std::memory_order_acquire); left != 0;
+            left = mCount.load(std::memory_order_acquire)) {
+            mCount.wait(left, std::memory_order_acquire);
+        }
+        while(!mNotified.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    std::atomic_size_t mCount;
+    std::atomic_bool mNotified;
+};
+
+template<size_t NTHREADS, size_t QUEUE_DEPTH, size_t TASK_SIZE> class StaticThreadPool;
+
+/**
+ * Result of StaticThreadPool::submit().  The result lives in the future itself, so the future can be neither copied
+ * nor moved: the pool's task writes straight into it.  The destructor waits for the task, so a future can't be
+ * dropped while its task still refers to it.
+ */
+template<typename R>
+class TaskFuture {
+public:
+    TaskFuture(const TaskFuture &) = delete;
+    TaskFuture &operator=(const TaskFuture &) = delete;
+    ~TaskFuture() { wait(); }
+
+    [[nodiscard]] bool ready() const { return mDone.tryWait(); }
+    void wait() const { mDone.wait(); }
+
+    /**
+     * Waits for the task and returns its result, or rethrows the exception it threw.  Call at most once.
+     */
+    R get() {
+        wait();
+        if(mError) {
+            std::rethrow_exception(mError);
+        }
+        if constexpr(!std::is_void_v<R>) {
+            return std::move(*mValue);
+        }
+    }
+
+private:
+    template<size_t, size_t, size_t> friend class StaticThreadPool;
+
+    // Constructed in place by submit() (guaranteed copy elision), which enqueues a task pointing at this.
+    template<typename SUBMIT>
+    explicit TaskFuture(SUBMIT &&submit) { submit(*this); }
+
+    template<typename FN>
+    void run(FN &fn) noexcept {
+        try {
+            if constexpr(std::is_void_v<R>) {
+                fn();
+            } else {
+                mValue.emplace(fn());
+            }
+        } catch(...) {
+            mError = std::current_exception();
+        }
+        mDone.countDown();     // the owner may destroy the future once this returns
+    }
+
+    std::optional<std::conditional_t<std::is_void_v<R>, bool, R>> mValue;
+    std::exception_ptr mError;
+    TaskLatch mDone{1};
+};
+
+/**
+ * Fixed size pool of NTHREADS workers, each with its own BlockingCircularQueue inbox of QUEUE_DEPTH tasks.  Tasks are
+ * StaticTask<TASK_SIZE> callables stored in the inbox slots and results are stored in the TaskFuture, so submitting
+ * work never allocates.  An idle worker spins briefly on its inbox and then parks until a task is pushed.
+ *
+ * Tasks go to the inboxes round-robin, skipping full ones; if every inbox is full the task runs on the calling
+ * thread, which throttles a submitter that outpaces the workers.  The inboxes are single producer, so post(),
+ * submit() and parallel_for() must all be called from one thread, e.g. the thread that owns the pool.
+ */
+template<size_t NTHREADS, size_t QUEUE_DEPTH, size_t TASK_SIZE = 48>
+class StaticThreadPool {
+    static_assert(NTHREADS > 0, "StaticThreadPool needs at least one thread.");
+
+public:
+    using Task = StaticTask<TASK_SIZE>;
+
+    StaticThreadPool() {
+        for(size_t i = 0; i < NTHREADS; i++) {
+            mThreads[i] = std::thread(&StaticThreadPool::work, this, i);
+        }
+    }
+    StaticThreadPool(const StaticThreadPool &) = delete;
+    StaticThreadPool &operator=(const StaticThreadPool &) = delete;
+
+    // Runs every task already queued, then stops the workers.
+    ~StaticThreadPool() {
+        for(auto &inbox: mInboxes) {
+            while(!inbox.push(Task{})) {     // an empty task tells the worker to exit
+                std::this_thread::yield();
+            }
+        }
+        for(auto &thread: mThreads) {
+            thread.join();
+        }
+    }
+
+    [[nodiscard]] size_t threads() const { return NTHREADS; }
+
+    /**
+     * Runs fn() on a worker with no way to wait for it.  An exception escaping fn terminates the program.
+     */
+    template<typename FN>
+    void post(FN &&fn) {
+        Task task(std::forward<FN>(fn));
+        for(size_t i = 0; i < NTHREADS; i++) {
+            auto &inbox = mInboxes[mNext];
+            mNext = mNext + 1 == NTHREADS ? 0 : mNext + 1;
+            if(inbox.push(std::move(task))) {
+                return;
+            }
+        }
+        task();     // every inbox is full
+    }
+
+    /**
+     * Runs fn() on a worker.  The returned future must be kept until the result is wanted, since its destructor
+     * waits: auto future = pool.submit(fn); ... future.get();
+     */
+    template<typename FN>
+    [[nodiscard]] TaskFuture<std::invoke_result_t<std::decay_t<FN> &>> submit(FN &&fn) {
+        using Future = TaskFuture<std::invoke_result_t<std::decay_t<FN> &>>;
+        return Future([this, &fn](Future &future) {
+            post([callable = std::decay_t<FN>(std::forward<FN>(fn)), &future]() mutable { future.run(callable); });
+        });
+    }
+
+    /**
+     * Calls fn(i) for every i in [begin, end), split into one contiguous chunk per worker plus one that runs on the
+     * calling thread, and returns when all of them are done.  fn must not throw.
+     */
+    template<typename FN>
+    void parallel_for(size_t begin, size_t end, FN &&fn) {
+        if(begin >= end) {
+            return;
+        }
+        const size_t chunks = std::min(NTHREADS + 1, end - begin);
+        const size_t chunkSize = (end - begin) / chunks;
+        const size_t remainder = (end - begin) % chunks;
+        TaskLatch pending(chunks - 1);     // safe to destroy on return, unlike a bare atomic counter
+
+        size_t lo = begin;
+        for(size_t chunk = 0; chunk + 1 < chunks; chunk++) {
+            const size_t hi = lo + chunkSize + (chunk < remainder ? 1 : 0);
+            post([&fn, &pending, lo, hi]() {
+                for(size_t i = lo; i < hi; i++) {
+                    fn(i);
+                }
+                pending.countDown();
+            });
+            lo = hi;
+        }
+        for(size_t i = lo; i < end; i++) {
+            fn(i);
+        }
+        pending.wait();
+    }
+
+private:
+    void work(size_t index) {
+        Task task;
+        for(;;) {
+            mInboxes[index].pop_wait(task);
+            if(!task) {
+                return;
+            }
+            task();
+            task = Task{};
+        }
+    }
+
+    std::array<BlockingCircularQueue<Task, QUEUE_DEPTH>, NTHREADS> mInboxes;
+    std::array<std::thread, NTHREADS> mThreads;
+    size_t mNext{0};    // submitting thread only
+};
+
+#endif //STATICCOLLECTIONS_STATICTHREADPOOL_H
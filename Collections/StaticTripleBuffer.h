@@ -0,0 +1,99 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_STATICTRIPLEBUFFER_H
+#define STATICCOLLECTIONS_STATICTRIPLEBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <utility>
+#include "CacheLine.h"
+
+/**
+ * Single-writer/single-reader "latest value wins" channel over three buffers: one the writer fills, one the reader
+ * reads and one in the middle holding the newest complete value.  Publishing swaps the writer's buffer with the
+ * middle one and taking a new value swaps the reader's buffer with the middle one, each a single atomic exchange of
+ * a byte that packs the middle index and a "new value" bit.  Neither side ever waits for the other, and values the
+ * reader didn't get to in time are simply replaced.
+ *
+ * Unlike StaticLatest, T can be any type (e.g. a config snapshot holding strings), and the writer can build the next
+ * value in place with writeBuffer()/publish().  The cost is three copies of T instead of one.
+ */
+template<typename T>
+class StaticTripleBuffer {
+public:
+    StaticTripleBuffer() = default;
+    explicit StaticTripleBuffer(const T &initial): mBuffers{{initial}, {initial}, {initial}} {}
+    StaticTripleBuffer(const StaticTripleBuffer &) = delete;
+    StaticTripleBuffer &operator=(const StaticTripleBuffer &) = delete;
+
+    /**
+     * Writer only.  Publishes a copy of value.
+     */
+    void write(const T &value) {
+        writeBuffer() = value;
+        publish();
+    }
+    void write(T &&value) {
+        writeBuffer() = std::move(value);
+        publish();
+    }
+
+    /**
+     * Writer only.  The buffer the next publish() hands over.  It holds an older value, not necessarily the last one
+     * written, so it must be filled in completely.
+     */
+    T &writeBuffer() { return mBuffers[mWrite].mValue; }
+
+    /**
+     * Writer only.  Makes the contents of writeBuffer() the newest value.
+     */
+    void publish() {
+        const auto previous = mState.exchange(mWrite | NEW_VALUE, std::memory_order_acq_rel);
+        mWrite = previous & INDEX_MASK;
+    }
+
+    /**
+     * Reader only.  Takes the newest value, if one was published since the last call.
+     *
+     * @return true if current() changed.
+     */
+    bool update() {
+        if(!(mState.load(std::memory_order_relaxed) & NEW_VALUE)) {
+            return false;
+        }
+        const auto previous = mState.exchange(mRead, std::memory_order_acq_rel);
+        mRead = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * Reader only.  update() and then current().
+     */
+    const T &read() {
+        update();
+        return current();
+    }
+
+    /**
+     * Reader only.  The value taken by the last update(); stays valid and unchanged until the next one.
+     */
+    const T &current() const { return mBuffers[mRead].mValue; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t NEW_VALUE = 0x4;
+
+    struct alignas(CACHE_LINE_SIZE) Buffer {
+        T mValue{};
+    };
+
+    Buffer mBuffers[3];
+    alignas(CACHE_LINE_SIZE) std::atomic_uint8_t mState{1};     // middle buffer index | NEW_VALUE
+    alignas(CACHE_LINE_SIZE) std::uint8_t mWrite{0};            // writer's buffer
+    alignas(CACHE_LINE_SIZE) std::uint8_t mRead{2};             // reader's buffer
+};
+
+#endif //STATICCOLLECTIONS_STATICTRIPLEBUFFER_H
@@ -5,19 +5,53 @@
 #ifndef STATICCOLLECTIONS_STATICVECTOR_H
 #define STATICCOLLECTIONS_STATICVECTOR_H
 
+#include <cstddef>
 #include <stdexcept>
 #include <initializer_list>
+#include <type_traits>
+#include <utility>
 #include "Vector.h"
 
+/**
+ * Vector with its SIZE element buffer stored inline.  The buffer is uninitialized, so only the size() elements in use
+ * are ever constructed: T needn't be default constructible and an empty StaticVector<std::string, 4096> constructs
+ * nothing.  Copying or moving copies or moves only those elements.
+ */
 template <class T, size_t SIZE>
-class StaticVector: public Vector<T> {
+class StaticVector final: public Vector<T> {
 private:
-    T mData[SIZE]{};
+    alignas(T) std::byte mStorage[SIZE * sizeof(T)];
+
+    T* storage() { return reinterpret_cast<T*>(mStorage); }
 
 public:
 
-    StaticVector(): Vector<T>(mData, SIZE) {}
-    StaticVector(const std::initializer_list<T> &initializerList): Vector<T>(mData, SIZE) {
+    StaticVector(): Vector<T>(uninitializedStorage, reinterpret_cast<T*>(mStorage), SIZE) {}
+    StaticVector(const StaticVector &other): StaticVector() { this->copyIn(other.data(), other.size()); }
+    // Moves the elements across one by one and leaves other empty.
+    StaticVector(StaticVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>): StaticVector() {
+        this->moveIn(other.storage(), other.size());
+        other.clear();
+    }
+    StaticVector &operator=(const StaticVector &other) {
+        if(this != &other) {
+            this->clear();
+            this->copyIn(other.data(), other.size());
+        }
+        return *this;
+    }
+    StaticVector &operator=(StaticVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if(this != &other) {
+            this->clear();
+            this->moveIn(other.storage(), other.size());
+            other.clear();
+        }
+        return *this;
+    }
+    // The elements live in mStorage, so they are destroyed here rather than by ~Vector(), after mStorage is gone.
+    ~StaticVector() { this->clear(); }
+
+    StaticVector(const std::initializer_list<T> &initializerList): StaticVector() {
         if(initializerList.size() > SIZE) {
             throw std::runtime_error("number of initializer elements exceeds capacity.");
         }
@@ -0,0 +1,141 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_STATICWORKSTEALINGDEQUE_H
+#define STATICCOLLECTIONS_STATICWORKSTEALINGDEQUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+#include "CacheLine.h"
+
+/**
+ * Bounded lock-free work-stealing deque (Chase-Lev, with the C11 memory orderings from Lê et al., "Correct and
+ * Efficient Work-Stealing for Weak Memory Models").  One owner thread pushes and pops at the bottom, LIFO, so it
+ * works on the most recently created (cache-hot) tasks; any number of thief threads steal from the top, FIFO, taking
+ * the oldest tasks.  The owner only contends with thieves for the last element; a thief contends with other thieves
+ * through a CAS on the top index.
+ *
+ * Unlike the original the buffer never grows: push() returns false when SIZE elements are queued, and the owner
+ * should then run the task itself.  SIZE must be a power of two.
+ *
+ * T must be trivially copyable, since a thief copies an element before it knows whether its CAS wins the element; a
+ * losing copy may race with the owner reusing the slot and is discarded.  Tasks are typically pointers or small
+ * handles.  The deque is not a Queue<T>: its push and pop are LIFO and only the owner may call them.
+ */
+template<typename T, size_t SIZE>
+class StaticWorkStealingDeque final {
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "StaticWorkStealingDeque SIZE must be a power of two.");
+    static_assert(std::is_trivially_copyable_v<T>, "StaticWorkStealingDeque elements must be trivially copyable.");
+
+public:
+    enum {CAPACITY = SIZE};
+
+    StaticWorkStealingDeque() = default;
+    StaticWorkStealingDeque(const StaticWorkStealingDeque &) = delete;
+    StaticWorkStealingDeque &operator=(const StaticWorkStealingDeque &) = delete;
+
+    /**
+     * Owner only.  Pushes item at the bottom.
+     *
+     * @return false if the deque is full.
+     */
+    bool push(const T& item);
+
+    /**
+     * Owner only.  Pops the most recently pushed element from the bottom.
+     *
+     * @return false if the deque is empty, or the last element was stolen first.
+     */
+    bool pop(T& item);
+    std::optional<T> pop() {
+        T item;
+        return pop(item) ? std::optional<T>{item} : std::nullopt;
+    }
+
+    /**
+     * Any thread.  Steals the oldest element from the top.  A steal that loses the race for an element to another
+     * thief or to the owner retries, so false means the deque was seen empty.
+     */
+    bool steal(T& item);
+    std::optional<T> steal() {
+        T item;
+        return steal(item) ? std::optional<T>{item} : std::nullopt;
+    }
+
+    // Snapshot; exact only when called by the owner with no thieves active.
+    [[nodiscard]] size_t size() const {
+        const auto top = mTop.load(std::memory_order_acquire);
+        const auto bottom = mBottom.load(std::memory_order_acquire);
+        return static_cast<size_t>(std::clamp<std::int64_t>(bottom - top, 0, SIZE));
+    }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] size_t capacity() const { return CAPACITY; }
+
+private:
+    static constexpr std::int64_t MASK = SIZE - 1;
+
+    // Signed so that the owner's tentative bottom - 1 on an empty deque compares below top.
+    alignas(CACHE_LINE_SIZE) std::atomic_int64_t mTop{0};       // next element to steal, advanced by CAS
+    alignas(CACHE_LINE_SIZE) std::atomic_int64_t mBottom{0};    // next free slot, written by the owner only
+    alignas(CACHE_LINE_SIZE) T mSlots[SIZE];
+};
+
+template<typename T, size_t SIZE>
+bool StaticWorkStealingDeque<T, SIZE>::push(const T &item) {
+    const auto bottom = mBottom.load(std::memory_order_relaxed);
+    const auto top = mTop.load(std::memory_order_acquire);
+    if(bottom - top >= static_cast<std::int64_t>(SIZE)) {
+        return false;  // full deque; a stale top only makes it look fuller
+    }
+    mSlots[bottom & MASK] = item;
+    mBottom.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+// The owner claims the bottom element by lowering mBottom first; the seq_cst fence orders that against its read of
+// mTop, pairing with the fence in steal(), so an owner and a thief can't both take the same element without one of
+// them seeing the other.  Only when a single element is left do they race for it through the CAS on mTop.
+template<typename T, size_t SIZE>
+bool StaticWorkStealingDeque<T, SIZE>::pop(T &item) {
+    const auto bottom = mBottom.load(std::memory_order_relaxed) - 1;
+    mBottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = mTop.load(std::memory_order_relaxed);
+
+    if(top > bottom) {
+        mBottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;  // empty deque
+    }
+    item = mSlots[bottom & MASK];
+    if(top < bottom) {
+        return true;   // more than one element, no thief can reach this one
+    }
+    const bool won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed);
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template<typename T, size_t SIZE>
+bool StaticWorkStealingDeque<T, SIZE>::steal(T &item) {
+    auto top = mTop.load(std::memory_order_acquire);
+    for(;;) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = mBottom.load(std::memory_order_acquire);
+        if(top >= bottom) {
+            return false;  // empty deque
+        }
+        item = mSlots[top & MASK];
+        if(mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_acquire)) {
+            return true;
+        }
+        // lost the element to another thief or the owner; top now holds the current value
+    }
+}
+
+#endif //STATICCOLLECTIONS_STATICWORKSTEALINGDEQUE_H
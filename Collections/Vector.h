@@ -6,9 +6,38 @@
 #define STATICCOLLECTIONS_VECTOR_H
 
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <new>
+#include <span>
 #include <stdexcept>
 #include <exception>
+#include <type_traits>
+#include <utility>
+#include "VectorScan.h"
 
+/**
+ * Tag for the Vector constructor that takes uninitialized memory rather than an array.
+ */
+struct UninitializedStorage {
+    explicit UninitializedStorage() = default;
+};
+inline constexpr UninitializedStorage uninitializedStorage{};
+
+/**
+ * Fixed capacity vector over a buffer it doesn't own.  None of its functions are virtual: a Vector<T>& already
+ * refers to a StaticVector of any SIZE, since the elements, size and capacity all live in this base class.  The
+ * buffer is raw storage: the first size() elements are constructed in place as they are added and destroyed as they
+ * are removed, and the slots beyond size() hold no objects.  For a trivial T that is no different from wrapping an
+ * array, so Vector(T*, size_t) takes one; any other T needs uninitialized memory, which is passed with the
+ * uninitializedStorage tag (StaticVector and SmallVector provide their own).
+ *
+ * The positional and bulk operations (insert, erase, append, resize) shift and copy trivially copyable elements with
+ * a single memmove/memcpy, and move other elements one at a time.  find, count, min, max and sum scan int32_t, uint32_t
+ * and float elements with SIMD kernels (see VectorScan.h).
+ */
 template <class T>
 class Vector {
 public:
@@ -28,7 +57,17 @@ protected:
     size_t mCount{0};
 
 public:
-    Vector(T *ptr, size_t capacity): mDataPtr{ptr}, mCapacity{capacity} {
+    /**
+     * Vector over an array of capacity elements.  Only for a trivial T, since the elements in use are constructed and
+     * destroyed by the vector: for any other T the array's own objects would be overwritten without being destroyed.
+     */
+    Vector(T *ptr, size_t capacity) requires std::is_trivial_v<T>: Vector(uninitializedStorage, ptr, capacity) {}
+
+    /**
+     * Vector over uninitialized memory for capacity elements, suitably aligned for T.  The memory must outlive the
+     * vector, and must hold no objects: the vector constructs and destroys the elements in use.
+     */
+    Vector(UninitializedStorage, T *ptr, size_t capacity): mDataPtr{ptr}, mCapacity{capacity} {
         if(!ptr) {
             throw std::invalid_argument("Vector constructor must have valid data ptr.");
         }
@@ -36,19 +75,172 @@ public:
             throw std::invalid_argument("Zero capacity Vector not permitted.");
         }
     }
+    // A copy would share the buffer; derived classes that own their storage copy the elements instead.
+    Vector(const Vector &) = delete;
+    Vector &operator=(const Vector &) = delete;
+    ~Vector() { clear(); }
+
+    bool push_back(const T& elem) { return emplace_back(elem); }
+    bool push_back(T&& elem) { return emplace_back(std::move(elem)); }
 
-    virtual bool push_back(const T& elem) {
+    /**
+     * Constructs an element in place at the end from args.
+     *
+     * @return false, without constructing anything, if the vector is full.
+     */
+    template<typename... ARGS>
+    bool emplace_back(ARGS&&... args) {
         if(mCount < mCapacity) {
-            mDataPtr[mCount++] = elem;
+            new(mDataPtr + mCount) T(std::forward<ARGS>(args)...);
+            mCount++;
             return true;
         }
         return false;
     }
 
-    virtual void pop_back() {
+    void pop_back() {
         if(mCount > 0) {
-            mCount--;
+            std::destroy_at(mDataPtr + --mCount);
+        }
+    }
+
+    /**
+     * Constructs an element in place from args before pos, moving the elements from pos on up by one.
+     *
+     * @return false, without constructing anything, if the vector is full.
+     */
+    template<typename... ARGS>
+    bool emplace(const_iterator pos, ARGS&&... args) {
+        const size_t index = indexOf(pos);
+        if(mCount == mCapacity) {
+            return false;
+        }
+        if(index == mCount) {
+            return emplace_back(std::forward<ARGS>(args)...);
+        }
+        T value(std::forward<ARGS>(args)...);   // before the move, in case args refer to an element
+        openGap(index, 1);
+        place(index, std::move(value));
+        mCount++;
+        return true;
+    }
+    bool insert(const_iterator pos, const T& elem) { return emplace(pos, elem); }
+    bool insert(const_iterator pos, T&& elem) { return emplace(pos, std::move(elem)); }
+
+    /**
+     * Copies items in before pos, moving the elements from pos on up by items.size().  items must not refer to
+     * elements of this vector.
+     *
+     * @return false, without inserting any of them, if the items don't all fit.
+     */
+    bool insert(const_iterator pos, std::span<const T> items) {
+        const size_t index = indexOf(pos);
+        const size_t count = items.size();
+        if(count > mCapacity - mCount) {
+            return false;
+        }
+        if(count == 0) {
+            return true;
+        }
+        openGap(index, count);
+        if constexpr(std::is_trivially_copyable_v<T>) {
+            std::memcpy(static_cast<void*>(mDataPtr + index), items.data(), count * sizeof(T));
+        } else {
+            for(size_t i = 0; i < count; i++) {
+                place(index + i, items[i]);
+            }
         }
+        mCount += count;
+        return true;
+    }
+
+    /**
+     * Copies items onto the end, with one memcpy for trivially copyable T.
+     *
+     * @return false, without appending any of them, if the items don't all fit.
+     */
+    bool append(std::span<const T> items) {
+        const size_t count = items.size();
+        if(count > mCapacity - mCount) {
+            return false;
+        }
+        if(count == 0) {
+            return true;
+        }
+        if constexpr(std::is_trivially_copyable_v<T>) {
+            std::memcpy(static_cast<void*>(mDataPtr + mCount), items.data(), count * sizeof(T));
+        } else {
+            std::uninitialized_copy_n(items.data(), count, mDataPtr + mCount);
+        }
+        mCount += count;
+        return true;
+    }
+
+    /**
+     * Removes the element at pos, moving the ones after it down.
+     *
+     * @return iterator to the element that followed the removed one.
+     */
+    iterator erase(const_iterator pos) {
+        if(indexOf(pos) == mCount) {
+            throw std::out_of_range("erase() called with end()");
+        }
+        return erase(pos, pos + 1);
+    }
+
+    /**
+     * Removes the elements in [first, last), moving the ones after them down.
+     *
+     * @return iterator to the element that followed the removed ones.
+     */
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_t index = indexOf(first);
+        const size_t endIndex = indexOf(last);
+        if(endIndex < index) {
+            throw std::out_of_range("erase() range is reversed");
+        }
+        const size_t count = endIndex - index;
+        if(count > 0) {
+            if constexpr(std::is_trivially_copyable_v<T>) {
+                std::memmove(static_cast<void*>(mDataPtr + index), mDataPtr + endIndex,
+                             (mCount - endIndex) * sizeof(T));
+            } else {
+                std::move(mDataPtr + endIndex, mDataPtr + mCount, mDataPtr + index);
+                std::destroy_n(mDataPtr + mCount - count, count);
+            }
+            mCount -= count;
+        }
+        return mDataPtr + index;
+    }
+
+    /**
+     * Destroys the elements past count, or appends value initialized (or value copy) elements up to count.
+     *
+     * @return false, leaving the vector unchanged, if count exceeds the capacity.
+     */
+    bool resize(size_t count) {
+        if(count > mCapacity) {
+            return false;
+        }
+        if(count < mCount) {
+            std::destroy_n(mDataPtr + count, mCount - count);
+        } else {
+            std::uninitialized_value_construct_n(mDataPtr + mCount, count - mCount);
+        }
+        mCount = count;
+        return true;
+    }
+    bool resize(size_t count, const T& value) {
+        if(count > mCapacity) {
+            return false;
+        }
+        if(count < mCount) {
+            std::destroy_n(mDataPtr + count, mCount - count);
+        } else {
+            std::uninitialized_fill_n(mDataPtr + mCount, count - mCount, value);
+        }
+        mCount = count;
+        return true;
     }
     const T* data() const { return mDataPtr; }
     [[nodiscard]] size_t size() const { return mCount; }
@@ -56,7 +248,10 @@ public:
     [[nodiscard]] bool empty() const { return mCount == 0; }
     [[nodiscard]] bool full() const { return mCount == mCapacity; }
 
-    void clear() { mCount = 0; }
+    void clear() {
+        std::destroy_n(mDataPtr, mCount);
+        mCount = 0;
+    }
     T& front() { if(empty()) { throw std::range_error("front() called on empty vector"); } return mDataPtr[0]; }
     T& back() { if(empty()) { throw std::range_error("back() called on empty vector"); } return mDataPtr[mCount-1]; }
     const T& front() const { if(empty()) { throw std::range_error("front() called on empty vector"); } return mDataPtr[0]; }
@@ -64,17 +259,104 @@ public:
 
     T& operator[](int index){ return const_cast<T&>((*const_cast<const Vector*>(this))[index]); }
     const T& operator[](int index) const {
-        if(index<0 || index>=mCapacity) {
+        if(index<0 || static_cast<size_t>(index)>=mCount) {
             throw std::out_of_range("Index out of range!");
         }
         return mDataPtr[index];
     }
 
+    /**
+     * @return the first element equal to value, or end() if there is none.
+     */
+    const_iterator find(const T& value) const { return mDataPtr + VectorScan<T>::find(mDataPtr, mCount, value); }
+    iterator find(const T& value) { return mDataPtr + VectorScan<T>::find(mDataPtr, mCount, value); }
+    [[nodiscard]] bool contains(const T& value) const { return find(value) != end(); }
+    [[nodiscard]] size_t count(const T& value) const { return VectorScan<T>::count(mDataPtr, mCount, value); }
+
+    T min() const requires std::is_arithmetic_v<T> {
+        if(empty()) { throw std::range_error("min() called on empty vector"); }
+        return VectorScan<T>::template extreme<false>(mDataPtr, mCount);
+    }
+    T max() const requires std::is_arithmetic_v<T> {
+        if(empty()) { throw std::range_error("max() called on empty vector"); }
+        return VectorScan<T>::template extreme<true>(mDataPtr, mCount);
+    }
+    // Integer elements are summed in 64 bits; see ScanSum.
+    ScanSum<T> sum() const requires std::is_arithmetic_v<T> { return VectorScan<T>::sum(mDataPtr, mCount); }
+
     iterator begin() {return iterator(data());}
     const_iterator begin() const {return const_iterator(data());}
     iterator end() {return iterator(data() + mCount);}
     const_iterator end() const {return const_iterator(data() + mCount);}
+
+private:
+    // Moves the elements from index on up by count, leaving mCount as it was.  Gap slots below mCount still hold
+    // moved-from elements and the rest are raw storage; place() assigns or constructs accordingly.
+    void openGap(size_t index, size_t count) {
+        if constexpr(std::is_trivially_copyable_v<T>) {
+            std::memmove(static_cast<void*>(mDataPtr + index + count), mDataPtr + index, (mCount - index) * sizeof(T));
+        } else {
+            T* const end = mDataPtr + mCount;
+            if(count < mCount - index) {
+                std::uninitialized_move(end - count, end, end);
+                std::move_backward(mDataPtr + index, end - count, end);
+            } else {
+                std::uninitialized_move(mDataPtr + index, end, mDataPtr + index + count);
+            }
+        }
+    }
+
+    template<typename U>
+    void place(size_t index, U&& value) {
+        if constexpr(std::is_trivially_copyable_v<T>) {
+            new(mDataPtr + index) T(std::forward<U>(value));
+        } else if(index >= mCount) {
+            new(mDataPtr + index) T(std::forward<U>(value));
+        } else {
+            mDataPtr[index] = std::forward<U>(value);
+        }
+    }
+
+protected:
+    // Index of pos, which may be end(); throws std::out_of_range for an iterator outside [begin(), end()].
+    size_t indexOf(const_iterator pos) const {
+        if(pos < mDataPtr || pos > mDataPtr + mCount) {
+            throw std::out_of_range("Iterator out of range!");
+        }
+        return static_cast<size_t>(pos - mDataPtr);
+    }
+
+    // Copy/move constructs count elements from items into an empty vector; the caller ensures they fit.
+    void copyIn(const T *items, size_t count) {
+        std::uninitialized_copy_n(items, count, mDataPtr);
+        mCount = count;
+    }
+    void moveIn(T *items, size_t count) {
+        std::uninitialized_move_n(items, count, mDataPtr);
+        mCount = count;
+    }
+};
+
+
+/**
+ * The Vector interface, for templates that accept any vector type.
+ */
+template<typename V>
+concept VectorType = requires(V &vector, const V &constVector, const typename V::value_type &constItem,
+                              typename V::value_type &&item) {
+    { vector.push_back(constItem) } -> std::same_as<bool>;
+    { vector.push_back(std::move(item)) } -> std::same_as<bool>;
+    vector.pop_back();
+    vector.clear();
+    { constVector.size() } -> std::same_as<size_t>;
+    { constVector.capacity() } -> std::same_as<size_t>;
+    { constVector.empty() } -> std::same_as<bool>;
+    { constVector.full() } -> std::same_as<bool>;
+    { constVector.data() } -> std::same_as<const typename V::value_type *>;
+    vector.begin();
+    vector.end();
 };
 
+static_assert(VectorType<Vector<int>>);
 
 #endif //STATICCOLLECTIONS_VECTOR_H
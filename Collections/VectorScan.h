@@ -0,0 +1,381 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#ifndef STATICCOLLECTIONS_VECTORSCAN_H
+#define STATICCOLLECTIONS_VECTORSCAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <numeric>
+#include <type_traits>
+
+/**
+ * The linear scans behind Vector's find, count, min, max and sum.  The compiler won't vectorize an early exit search
+ * such as std::find, so for int32_t, uint32_t and float elements on x86 these run hand written SSE2 kernels, or AVX2
+ * ones when the CPU supports it (checked once, via CPUID, at static initialization).  Any other element type, or any
+ * other target, runs the plain loops.  Define STATICCOLLECTIONS_NO_SIMD to always run the plain loops.
+ *
+ * The vector kernels visit the elements in a different order, which only shows in a float sum (rounded differently)
+ * and in a float min or max of elements that include a NaN (unspecified).
+ */
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(STATICCOLLECTIONS_NO_SIMD)
+#define STATICCOLLECTIONS_SIMD_SCAN 1
+#include <immintrin.h>
+#endif
+
+/**
+ * The type sum() accumulates and returns: 64 bits for integers, so that summing int32_t elements doesn't overflow.
+ */
+template<typename T>
+using ScanSum = std::conditional_t<std::is_floating_point_v<T>, T,
+                                   std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+#if defined(STATICCOLLECTIONS_SIMD_SCAN)
+
+/**
+ * Element types the SIMD kernels handle.
+ */
+template<typename T>
+concept SimdScanLane = std::same_as<T, std::int32_t> || std::same_as<T, std::uint32_t> || std::same_as<T, float>;
+
+/**
+ * Kernels over 128 bit SSE2 vectors, which every x86-64 CPU has.  SSE2 lacks 32 bit integer min/max, so those compare
+ * and blend, biasing unsigned values into signed range first.
+ */
+struct Sse2Scan {
+    static constexpr size_t LANES = 4;
+
+    template<SimdScanLane L>
+    static size_t find(const L *data, size_t size, L value) {
+        const auto needle = splat(value);
+        size_t i = 0;
+        for(; i + 4 * LANES <= size; i += 4 * LANES) {
+            const auto any = orMask(orMask(equal(load(data + i), needle), equal(load(data + i + LANES), needle)),
+                                    orMask(equal(load(data + i + 2 * LANES), needle),
+                                           equal(load(data + i + 3 * LANES), needle)));
+            if(mask(any)) {
+                break;      // the single vector loop below finds which lane
+            }
+        }
+        for(; i + LANES <= size; i += LANES) {
+            if(const unsigned bits = mask(equal(load(data + i), needle))) {
+                return i + std::countr_zero(bits);
+            }
+        }
+        for(; i < size; i++) {
+            if(data[i] == value) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    template<SimdScanLane L>
+    static size_t count(const L *data, size_t size, L value) {
+        const auto needle = splat(value);
+        size_t matches = 0;
+        size_t i = 0;
+        for(; i + LANES <= size; i += LANES) {
+            matches += std::popcount(mask(equal(load(data + i), needle)));
+        }
+        for(; i < size; i++) {
+            matches += data[i] == value;
+        }
+        return matches;
+    }
+
+    // size must be at least 1.
+    template<bool MAX, SimdScanLane L>
+    static L extreme(const L *data, size_t size) {
+        size_t i = 0;
+        L result = data[0];
+        if(size >= LANES) {
+            auto best = load(data);
+            for(i = LANES; i + LANES <= size; i += LANES) {
+                best = pick<MAX>(best, load(data + i), L{});
+            }
+            alignas(16) L lanes[LANES];
+            store(lanes, best);
+            result = MAX ? *std::max_element(lanes, lanes + LANES) : *std::min_element(lanes, lanes + LANES);
+        }
+        for(; i < size; i++) {
+            result = MAX ? std::max(result, data[i]) : std::min(result, data[i]);
+        }
+        return result;
+    }
+
+    template<SimdScanLane L>
+    static ScanSum<L> sum(const L *data, size_t size) {
+        size_t i = 0;
+        ScanSum<L> total{};
+        if constexpr(std::is_same_v<L, float>) {
+            __m128 acc = _mm_setzero_ps();
+            for(; i + LANES <= size; i += LANES) {
+                acc = _mm_add_ps(acc, _mm_loadu_ps(data + i));
+            }
+            alignas(16) float lanes[LANES];
+            _mm_store_ps(lanes, acc);
+            total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        } else {
+            __m128i acc = _mm_setzero_si128();     // two 64 bit sums
+            for(; i + LANES <= size; i += LANES) {
+                const __m128i v = load(data + i);
+                const __m128i high = std::is_signed_v<L> ? _mm_srai_epi32(v, 31) : _mm_setzero_si128();
+                acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, high));
+                acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, high));
+            }
+            alignas(16) std::uint64_t lanes[2];
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+            total = static_cast<ScanSum<L>>(lanes[0] + lanes[1]);
+        }
+        for(; i < size; i++) {
+            total += data[i];
+        }
+        return total;
+    }
+
+private:
+    static __m128i load(const std::int32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static __m128i load(const std::uint32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static __m128 load(const float *p) { return _mm_loadu_ps(p); }
+    static void store(std::int32_t *p, __m128i v) { _mm_store_si128(reinterpret_cast<__m128i *>(p), v); }
+    static void store(std::uint32_t *p, __m128i v) { _mm_store_si128(reinterpret_cast<__m128i *>(p), v); }
+    static void store(float *p, __m128 v) { _mm_store_ps(p, v); }
+    static __m128i splat(std::int32_t x) { return _mm_set1_epi32(x); }
+    static __m128i splat(std::uint32_t x) { return _mm_set1_epi32(static_cast<std::int32_t>(x)); }
+    static __m128 splat(float x) { return _mm_set1_ps(x); }
+    static __m128i equal(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+    static __m128 equal(__m128 a, __m128 b) { return _mm_cmpeq_ps(a, b); }
+    static __m128i orMask(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+    static __m128 orMask(__m128 a, __m128 b) { return _mm_or_ps(a, b); }
+    static unsigned mask(__m128i v) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(v))); }
+    static unsigned mask(__m128 v) { return static_cast<unsigned>(_mm_movemask_ps(v)); }
+
+    // The last argument selects the lane type.
+    template<bool MAX>
+    static __m128 pick(__m128 a, __m128 b, float) { return MAX ? _mm_max_ps(a, b) : _mm_min_ps(a, b); }
+    template<bool MAX>
+    static __m128i pick(__m128i a, __m128i b, std::int32_t) {
+        const __m128i takeB = MAX ? _mm_cmpgt_epi32(b, a) : _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(takeB, b), _mm_andnot_si128(takeB, a));
+    }
+    template<bool MAX>
+    static __m128i pick(__m128i a, __m128i b, std::uint32_t) {
+        const __m128i bias = _mm_set1_epi32(INT32_MIN);
+        const __m128i aBiased = _mm_xor_si128(a, bias);
+        const __m128i bBiased = _mm_xor_si128(b, bias);
+        const __m128i takeB = MAX ? _mm_cmpgt_epi32(bBiased, aBiased) : _mm_cmpgt_epi32(aBiased, bBiased);
+        return _mm_or_si128(_mm_and_si128(takeB, b), _mm_andnot_si128(takeB, a));
+    }
+};
+
+/**
+ * The same kernels over 256 bit AVX2 vectors.  Every function is compiled for AVX2 and must only be called when
+ * SimdScanSupport::AVX2 is true.
+ */
+struct Avx2Scan {
+    static constexpr size_t LANES = 8;
+
+    template<SimdScanLane L>
+    [[gnu::target("avx2")]] static size_t find(const L *data, size_t size, L value) {
+        const auto needle = splat(value);
+        size_t i = 0;
+        for(; i + 4 * LANES <= size; i += 4 * LANES) {
+            const auto any = orMask(orMask(equal(load(data + i), needle), equal(load(data + i + LANES), needle)),
+                                    orMask(equal(load(data + i + 2 * LANES), needle),
+                                           equal(load(data + i + 3 * LANES), needle)));
+            if(mask(any)) {
+                break;      // the single vector loop below finds which lane
+            }
+        }
+        for(; i + LANES <= size; i += LANES) {
+            if(const unsigned bits = mask(equal(load(data + i), needle))) {
+                return i + std::countr_zero(bits);
+            }
+        }
+        for(; i < size; i++) {
+            if(data[i] == value) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    template<SimdScanLane L>
+    [[gnu::target("avx2")]] static size_t count(const L *data, size_t size, L value) {
+        const auto needle = splat(value);
+        size_t matches = 0;
+        size_t i = 0;
+        for(; i + LANES <= size; i += LANES) {
+            matches += std::popcount(mask(equal(load(data + i), needle)));
+        }
+        for(; i < size; i++) {
+            matches += data[i] == value;
+        }
+        return matches;
+    }
+
+    // size must be at least 1.
+    template<bool MAX, SimdScanLane L>
+    [[gnu::target("avx2")]] static L extreme(const L *data, size_t size) {
+        size_t i = 0;
+        L result = data[0];
+        if(size >= LANES) {
+            auto best = load(data);
+            for(i = LANES; i + LANES <= size; i += LANES) {
+                best = pick<MAX>(best, load(data + i), L{});
+            }
+            alignas(32) L lanes[LANES];
+            store(lanes, best);
+            result = MAX ? *std::max_element(lanes, lanes + LANES) : *std::min_element(lanes, lanes + LANES);
+        }
+        for(; i < size; i++) {
+            result = MAX ? std::max(result, data[i]) : std::min(result, data[i]);
+        }
+        return result;
+    }
+
+    template<SimdScanLane L>
+    [[gnu::target("avx2")]] static ScanSum<L> sum(const L *data, size_t size) {
+        size_t i = 0;
+        ScanSum<L> total{};
+        if constexpr(std::is_same_v<L, float>) {
+            __m256 acc = _mm256_setzero_ps();
+            for(; i + LANES <= size; i += LANES) {
+                acc = _mm256_add_ps(acc, _mm256_loadu_ps(data + i));
+            }
+            alignas(32) float lanes[LANES];
+            _mm256_store_ps(lanes, acc);
+            total = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+        } else {
+            __m256i acc = _mm256_setzero_si256();   // four 64 bit sums
+            for(; i + LANES <= size; i += LANES) {
+                const __m256i v = load(data + i);
+                const __m128i low = _mm256_castsi256_si128(v);
+                const __m128i high = _mm256_extracti128_si256(v, 1);
+                if constexpr(std::is_signed_v<L>) {
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(low));
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(high));
+                } else {
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(low));
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(high));
+                }
+            }
+            alignas(32) std::uint64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+            total = static_cast<ScanSum<L>>((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+        }
+        for(; i < size; i++) {
+            total += data[i];
+        }
+        return total;
+    }
+
+private:
+    [[gnu::target("avx2")]] static __m256i load(const std::int32_t *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+    [[gnu::target("avx2")]] static __m256i load(const std::uint32_t *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+    [[gnu::target("avx2")]] static __m256 load(const float *p) { return _mm256_loadu_ps(p); }
+    [[gnu::target("avx2")]] static void store(std::int32_t *p, __m256i v) {
+        _mm256_store_si256(reinterpret_cast<__m256i *>(p), v);
+    }
+    [[gnu::target("avx2")]] static void store(std::uint32_t *p, __m256i v) {
+        _mm256_store_si256(reinterpret_cast<__m256i *>(p), v);
+    }
+    [[gnu::target("avx2")]] static void store(float *p, __m256 v) { _mm256_store_ps(p, v); }
+    [[gnu::target("avx2")]] static __m256i splat(std::int32_t x) { return _mm256_set1_epi32(x); }
+    [[gnu::target("avx2")]] static __m256i splat(std::uint32_t x) {
+        return _mm256_set1_epi32(static_cast<std::int32_t>(x));
+    }
+    [[gnu::target("avx2")]] static __m256 splat(float x) { return _mm256_set1_ps(x); }
+    [[gnu::target("avx2")]] static __m256i equal(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+    [[gnu::target("avx2")]] static __m256 equal(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    [[gnu::target("avx2")]] static __m256i orMask(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+    [[gnu::target("avx2")]] static __m256 orMask(__m256 a, __m256 b) { return _mm256_or_ps(a, b); }
+    [[gnu::target("avx2")]] static unsigned mask(__m256i v) {
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(v)));
+    }
+    [[gnu::target("avx2")]] static unsigned mask(__m256 v) { return static_cast<unsigned>(_mm256_movemask_ps(v)); }
+
+    // The last argument selects the lane type.
+    template<bool MAX>
+    [[gnu::target("avx2")]] static __m256 pick(__m256 a, __m256 b, float) {
+        return MAX ? _mm256_max_ps(a, b) : _mm256_min_ps(a, b);
+    }
+    template<bool MAX>
+    [[gnu::target("avx2")]] static __m256i pick(__m256i a, __m256i b, std::int32_t) {
+        return MAX ? _mm256_max_epi32(a, b) : _mm256_min_epi32(a, b);
+    }
+    template<bool MAX>
+    [[gnu::target("avx2")]] static __m256i pick(__m256i a, __m256i b, std::uint32_t) {
+        return MAX ? _mm256_max_epu32(a, b) : _mm256_min_epu32(a, b);
+    }
+};
+
+/**
+ * Whether the CPU (and OS) support AVX2.  Zero initialized, and so false, for any scan that runs before this
+ * initializer, which then just uses SSE2.
+ */
+struct SimdScanSupport {
+    static inline const bool AVX2 = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+};
+
+#endif
+
+/**
+ * Picks a kernel for T: AVX2 or SSE2 where available, a plain loop otherwise.
+ */
+template<typename T>
+struct VectorScan {
+    // Index of the first element equal to value, or size if there is none.
+    static size_t find(const T *data, size_t size, const T &value) {
+#if defined(STATICCOLLECTIONS_SIMD_SCAN)
+        if constexpr(SimdScanLane<T>) {
+            return SimdScanSupport::AVX2 ? Avx2Scan::find(data, size, value) : Sse2Scan::find(data, size, value);
+        }
+#endif
+        return static_cast<size_t>(std::find(data, data + size, value) - data);
+    }
+
+    static size_t count(const T *data, size_t size, const T &value) {
+#if defined(STATICCOLLECTIONS_SIMD_SCAN)
+        if constexpr(SimdScanLane<T>) {
+            return SimdScanSupport::AVX2 ? Avx2Scan::count(data, size, value) : Sse2Scan::count(data, size, value);
+        }
+#endif
+        return static_cast<size_t>(std::count(data, data + size, value));
+    }
+
+    // size must be at least 1.
+    template<bool MAX>
+    static T extreme(const T *data, size_t size) {
+#if defined(STATICCOLLECTIONS_SIMD_SCAN)
+        if constexpr(SimdScanLane<T>) {
+            return SimdScanSupport::AVX2 ? Avx2Scan::extreme<MAX>(data, size) : Sse2Scan::extreme<MAX>(data, size);
+        }
+#endif
+        return MAX ? *std::max_element(data, data + size) : *std::min_element(data, data + size);
+    }
+
+    static ScanSum<T> sum(const T *data, size_t size) requires std::is_arithmetic_v<T> {
+#if defined(STATICCOLLECTIONS_SIMD_SCAN)
+        if constexpr(SimdScanLane<T>) {
+            return SimdScanSupport::AVX2 ? Avx2Scan::sum(data, size) : Sse2Scan::sum(data, size);
+        }
+#endif
+        return std::accumulate(data, data + size, ScanSum<T>{});
+    }
+};
+
+#endif //STATICCOLLECTIONS_VECTORSCAN_H
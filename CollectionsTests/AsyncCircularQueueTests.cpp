@@ -0,0 +1,156 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/AsyncCircularQueue.h"
+#include "doctest.h"
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Eagerly started coroutine that destroys itself when it finishes.
+    struct Detached {
+        struct promise_type {
+            Detached get_return_object() { return {}; }
+            std::suspend_never initial_suspend() { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    template<typename QUEUE>
+    Detached receive(QUEUE &queue, int count, std::vector<int> &received) {
+        for(int i = 0; i < count; i++) {
+            received.push_back(co_await queue.async_pop());
+        }
+    }
+
+    template<typename QUEUE>
+    Detached send(QUEUE &queue, int first, int count, bool &done) {
+        for(int i = first; i < first + count; i++) {
+            co_await queue.async_push(i);
+        }
+        done = true;
+    }
+}
+
+TEST_CASE("AsyncCircularQueue behaves like a CircularQueue") {
+    AsyncCircularQueue<int, 4> queue = {1, 2, 3};
+    REQUIRE(queue.size() == 3);
+    REQUIRE(queue.push(4));
+    REQUIRE(queue.full());
+    REQUIRE_FALSE(queue.push(5));
+
+    int value;
+    REQUIRE(queue.peek(value));
+    REQUIRE(value == 1);
+    REQUIRE(queue.popElements(2));
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 3);
+    REQUIRE(queue.pop() == 4);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("AsyncCircularQueue consumer is resumed inline by the next push") {
+    AsyncCircularQueue<int, 4> queue;
+    std::vector<int> received;
+    receive(queue, 3, received);
+    REQUIRE(received.empty());          // suspended on the empty queue
+
+    REQUIRE(queue.push(10));
+    REQUIRE(received == std::vector<int>{10});
+    REQUIRE(queue.empty());
+
+    const int items[]{11, 12};
+    REQUIRE(queue.push(items, 2));
+    REQUIRE(received == std::vector<int>{10, 11, 12});
+    REQUIRE(queue.push(13));            // the coroutine has finished, nobody left to resume
+    REQUIRE(queue.size() == 1);
+}
+
+TEST_CASE("AsyncCircularQueue producer is resumed inline by the next pop") {
+    AsyncCircularQueue<std::unique_ptr<int>, 2> queue;
+    bool done = false;
+    [](auto &q, bool &finished) -> Detached {
+        for(int i = 0; i < 4; i++) {
+            co_await q.async_push(std::make_unique<int>(i));
+        }
+        finished = true;
+    }(queue, done);
+    REQUIRE(queue.full());
+    REQUIRE_FALSE(done);
+
+    for(int i = 0; i < 4; i++) {
+        auto item = queue.pop();
+        REQUIRE(item.has_value());
+        REQUIRE(**item == i);
+    }
+    REQUIRE(done);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("AsyncCircularQueue zero count calls resume nobody") {
+    AsyncCircularQueue<int, 2> queue;
+    std::vector<int> received;
+    receive(queue, 1, received);
+
+    //Each succeeds without moving an element, so the waiting consumer stays parked.
+    int items[2]{};
+    REQUIRE(queue.push(items, 0));
+    REQUIRE(queue.pushUpTo(items, 0) == 0);
+    REQUIRE(queue.pop(items, 0));
+    REQUIRE(queue.popElements(0));
+    REQUIRE(received.empty());
+    REQUIRE(queue.push(7));
+    REQUIRE(received == std::vector<int>{7});
+
+    bool done = false;
+    send(queue, 0, 3, done);
+    REQUIRE(queue.full());
+    REQUIRE(queue.pop(items, 0));
+    REQUIRE(queue.popElements(0));
+    REQUIRE(queue.popUpTo(items, 0) == 0);
+    REQUIRE_FALSE(done);                // the waiting producer stays parked too
+    REQUIRE(queue.popElements(1));
+    REQUIRE(done);
+    REQUIRE(queue.size() == 2);
+}
+
+TEST_CASE("AsyncCircularQueue coroutines hand off on one thread") {
+    AsyncCircularQueue<int, 2> queue;
+    std::vector<int> received;
+    bool sent = false;
+    receive(queue, 100, received);
+    send(queue, 0, 100, sent);
+    REQUIRE(sent);
+    REQUIRE(received.size() == 100);
+    for(int i = 0; i < 100; i++) {
+        REQUIRE(received[i] == i);
+    }
+}
+
+TEST_CASE("AsyncCircularQueue thread safe coroutines on different threads") {
+    constexpr int count = 200000;
+    AsyncCircularQueue<int, 16, true> queue;
+    std::vector<int> received;
+    received.reserve(count);
+    bool sent = false;
+
+    // Coroutines only ever run on these two threads, so once both are joined neither is running.
+    std::thread consumer([&]() { receive(queue, count, received); });
+    std::thread producer([&]() { send(queue, 0, count, sent); });
+    consumer.join();
+    producer.join();
+
+    REQUIRE(sent);
+    REQUIRE(received.size() == count);
+    for(int i = 0; i < count; i++) {
+        REQUIRE(received[i] == i);
+    }
+    REQUIRE(queue.empty());
+}
@@ -0,0 +1,106 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/BlockingCircularQueue.h"
+#include "doctest.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("BlockingCircularQueue behaves like a CircularQueue") {
+    BlockingCircularQueue<int, 4> queue = {1, 2, 3};
+    REQUIRE(queue.size() == 3);
+    REQUIRE(queue.push(4));
+    REQUIRE(queue.full());
+    REQUIRE_FALSE(queue.push(5));
+
+    int value;
+    REQUIRE(queue.peek(value));
+    REQUIRE(value == 1);
+    REQUIRE(queue.getBlock().size() == 4);
+    REQUIRE(queue.popElements(2));
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 3);
+
+    const auto block = queue.reserveBlock();
+    REQUIRE(block.size() == 3);
+    block[0] = 5;
+    REQUIRE(queue.commit(1));
+    int out[2];
+    REQUIRE(queue.popUpTo(out, 2) == 2);
+    REQUIRE(out[0] == 4);
+    REQUIRE(out[1] == 5);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("BlockingCircularQueue timed waits expire") {
+    BlockingCircularQueue<int, 2> queue;
+    int value;
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE_FALSE(queue.pop_wait_for(value, 5ms));
+    REQUIRE(std::chrono::steady_clock::now() - start >= 5ms);
+
+    REQUIRE(queue.push_wait_for(1, 5ms));
+    REQUIRE(queue.push_wait_for(2, 5ms));
+    REQUIRE_FALSE(queue.push_wait_for(3, 5ms));
+    REQUIRE(queue.pop_wait_for(value, 5ms));
+    REQUIRE(value == 1);
+}
+
+TEST_CASE("BlockingCircularQueue timed wait is satisfied by the other thread") {
+    BlockingCircularQueue<int, 2> queue;
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(2ms);
+        queue.push(42);
+    });
+    int value = 0;
+    REQUIRE(queue.pop_wait_for(value, 10s));
+    REQUIRE(value == 42);
+    producer.join();
+}
+
+TEST_CASE("BlockingCircularQueue consumer parks until the producer pushes") {
+    BlockingCircularQueue<int, 4> queue;
+    int value = 0;
+    std::thread consumer([&queue, &value]() {
+        queue.pop_wait(value);
+    });
+    std::this_thread::sleep_for(5ms);
+    queue.push(7);
+    consumer.join();
+    REQUIRE(value == 7);
+}
+
+TEST_CASE("BlockingCircularQueue producer parks until the consumer pops") {
+    BlockingCircularQueue<int, 2> queue = {1, 2};
+    std::thread producer([&queue]() {
+        queue.push_wait(3);
+    });
+    std::this_thread::sleep_for(5ms);
+    int value;
+    REQUIRE(queue.pop(value));
+    producer.join();
+    REQUIRE(queue.size() == 2);
+}
+
+TEST_CASE("BlockingCircularQueue streams with both sides blocking") {
+    constexpr int NUM_ELEMENTS = 200'000;
+    static BlockingCircularQueue<int, 16> queue;
+    std::thread producer([]() {
+        for(int i = 0; i < NUM_ELEMENTS; i++) {
+            queue.push_wait(i);
+        }
+    });
+    bool inOrder = true;
+    for(int expected = 0; expected < NUM_ELEMENTS; expected++) {
+        int value;
+        queue.pop_wait(value);
+        inOrder = inOrder && value == expected;
+    }
+    producer.join();
+    REQUIRE(inOrder);
+    REQUIRE(queue.empty());
+}
@@ -0,0 +1,135 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/BroadcastRing.h"
+#include "doctest.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("BroadcastRing delivers every element to every consumer") {
+    BroadcastRing<int, 4, 2> ring;
+    const auto first = ring.registerConsumer();
+    const auto second = ring.registerConsumer();
+    REQUIRE_THROWS_AS(ring.registerConsumer(), std::runtime_error);
+
+    REQUIRE(ring.push(1));
+    REQUIRE(ring.push(2));
+    int value;
+    REQUIRE(ring.pop(first, value));
+    REQUIRE(value == 1);
+    REQUIRE(ring.size(first) == 1);
+    REQUIRE(ring.size(second) == 2);
+
+    const int items[]{3, 4, 5};
+    REQUIRE_FALSE(ring.push(items, 3));         // second hasn't read anything, so only two slots are free
+    REQUIRE(ring.pushUpTo(items, 3) == 2);
+    REQUIRE_FALSE(ring.push(5));
+
+    std::vector<int> seen;
+    REQUIRE(ring.consume(second, [&seen](const int &item) { seen.push_back(item); }, 3) == 3);
+    REQUIRE(seen == std::vector<int>{1, 2, 3});
+    REQUIRE(ring.push(5));                      // first is now the slowest, one element behind second
+
+    REQUIRE(ring.pop(first, value));
+    REQUIRE(value == 2);
+    REQUIRE(ring.size(first) == 3);
+    REQUIRE(ring.size(second) == 2);
+}
+
+TEST_CASE("BroadcastRing getBlock gives zero-copy spans") {
+    BroadcastRing<int, 8> ring;
+    const auto consumer = ring.registerConsumer();
+    const int items[]{0, 1, 2, 3, 4, 5};
+    REQUIRE(ring.push(items, 6));
+    REQUIRE(ring.popElements(consumer, 6));
+
+    // wraps around the end of the storage, so the unread elements are in two runs
+    const int more[]{6, 7, 8, 9, 10};
+    REQUIRE(ring.push(more, 5));
+    auto block = ring.getBlock(consumer);
+    REQUIRE(block.size() == 2);
+    REQUIRE(block[0] == 6);
+    REQUIRE(ring.popElements(consumer, block.size()));
+    block = ring.getBlock(consumer);
+    REQUIRE(block.size() == 3);
+    REQUIRE(block[2] == 10);
+    REQUIRE(ring.popElements(consumer, 10));    // clamped to what is there
+    REQUIRE(ring.getBlock(consumer).empty());
+}
+
+TEST_CASE("BroadcastRing without consumers drops elements, unregister releases the producer") {
+    BroadcastRing<int, 2> ring;
+    for(int i = 0; i < 10; i++) {
+        REQUIRE(ring.push(i));
+    }
+    const auto stalled = ring.registerConsumer();
+    REQUIRE(ring.push(10));
+    REQUIRE(ring.push(11));
+    REQUIRE_FALSE(ring.push(12));
+    REQUIRE(ring.size(stalled) == 2);
+    ring.unregisterConsumer(stalled);
+    REQUIRE(ring.size(stalled) == 0);
+    REQUIRE(ring.push(12));
+    REQUIRE(ring.size(1) == 0);         // never registered
+}
+
+TEST_CASE("BroadcastRing fans out across threads") {
+    constexpr std::uint64_t count = 300000;
+    constexpr int consumers = 3;
+    BroadcastRing<std::uint64_t, 256, consumers> ring;
+    std::vector<size_t> ids;
+    for(int i = 0; i < consumers; i++) {
+        ids.push_back(ring.registerConsumer());
+    }
+
+    std::vector<std::uint64_t> sums(consumers, 0);
+    std::vector<char> ordered(consumers, true);
+    std::vector<std::thread> threads;
+    for(int c = 0; c < consumers; c++) {
+        threads.emplace_back([&, c]() {
+            std::uint64_t expected = 0;
+            std::uint64_t sum = 0;
+            bool inOrder = true;
+            while(expected < count) {
+                // alternate the batch APIs between consumers
+                if(c == 0) {
+                    const auto block = ring.getBlock(ids[c]);
+                    for(auto value: block) {
+                        inOrder = inOrder && value == expected++;
+                        sum += value;
+                    }
+                    ring.popElements(ids[c], block.size());
+                } else {
+                    ring.consume(ids[c], [&](std::uint64_t value) {
+                        inOrder = inOrder && value == expected++;
+                        sum += value;
+                    });
+                }
+            }
+            sums[c] = sum;
+            ordered[c] = inOrder;
+        });
+    }
+
+    std::uint64_t batch[32];
+    for(std::uint64_t next = 0; next < count;) {
+        size_t n = 0;
+        while(n < 32 && next + n < count) {
+            batch[n] = next + n;
+            n++;
+        }
+        next += ring.pushUpTo(batch, n);
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+
+    for(int c = 0; c < consumers; c++) {
+        REQUIRE(ordered[c]);
+        REQUIRE(sums[c] == count * (count - 1) / 2);
+    }
+}
@@ -1,5 +1,11 @@
 #include "../Collections/CircularQueue.h"
 
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
@@ -130,21 +136,358 @@ TEST_CASE( "CircularQueue block test") {
         REQUIRE(memcmp(queue.getBlock().data(), expected, sizeof(int) * 2) == 0);
     }
 
-    //Now push two new elements to the queue.  Note that a CircularQueue with the capacity of 4 actually
-    //has storage for 5.  The queue now store the first added element in the array[4] location, and wrap around
-    //and store the remaining element at index 0.  At this point the elements of the queue are NOT
-    //contiguous and will require that getBlock() be called to get at the first three elements, then
+    //Now push two new elements to the queue.  All 4 slots of the storage are usable, so the new elements
+    //wrap around and are stored at index 0 and 1.  At this point the elements of the queue are NOT
+    //contiguous and will require that getBlock() be called to get at the first two elements, then
     //we pop those elements.  Follow with another getBlock() that will return a span of the
-    //remaining element.
+    //remaining elements.
     {
         REQUIRE(queue.push(7));
         REQUIRE(queue.push(8));
-        REQUIRE(queue.getBlock().size() == 3);
-        const int expected0[]{2, 1, 7};
+        REQUIRE(queue.full());
+        REQUIRE(queue.getBlock().size() == 2);
+        const int expected0[]{2, 1};
         REQUIRE(memcmp(queue.getBlock().data(), expected0, sizeof(int) * queue.getBlock().size()) == 0);
         REQUIRE(queue.popElements(queue.getBlock().size()));
-        const int expected1[]{8};
-        REQUIRE(queue.getBlock().size() == 1);
+        const int expected1[]{7, 8};
+        REQUIRE(queue.getBlock().size() == 2);
         REQUIRE(memcmp(queue.getBlock().data(), expected1, sizeof(int) * queue.getBlock().size()) == 0);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "CircularQueue wraps many times") {
+    //Power of two capacity (masked indices) and a non power of two capacity (modulo indices) must behave the same.
+    CircularQueue<int, 8> pow2Queue;
+    CircularQueue<int, 5> queue;
+    int next = 0;
+    int expected = 0;
+    for(int round = 0; round < 100; round++) {
+        while(queue.push(next)) {
+            REQUIRE(pow2Queue.push(next));
+            next++;
+        }
+        REQUIRE(queue.size() == 5);
+        REQUIRE(queue.full());
+        for(int i = 0; i < 3; i++) {
+            int value;
+            int pow2Value;
+            REQUIRE(queue.pop(value));
+            REQUIRE(pow2Queue.pop(pow2Value));
+            REQUIRE(value == expected);
+            REQUIRE(pow2Value == expected);
+            expected++;
+        }
+        REQUIRE(queue.size() == 2);
+        REQUIRE(pow2Queue.size() == 2);
+    }
+}
+
+namespace {
+    // The CircularQueue layout prior to the SPSC rework: sequentially consistent indices sharing cache lines
+    // with each other and the data.  Kept here only as a throughput reference.
+    template<typename T, size_t SIZE>
+    class SeqCstReferenceQueue {
+    public:
+        bool push(const T &item) {
+            const auto current_tail = mTail.load();
+            const auto next_tail = (current_tail + 1) % std::size(mArray);
+            if(next_tail != mHead.load()) {
+                mArray[current_tail] = item;
+                mTail.store(next_tail);
+                return true;
+            }
+            return false;
+        }
+
+        bool pop(T &item) {
+            const auto current_head = mHead.load();
+            if(current_head == mTail.load()) {
+                return false;
+            }
+            item = mArray[current_head];
+            mHead.store((current_head + 1) % std::size(mArray));
+            return true;
+        }
+
+    private:
+        std::atomic_size_t mTail{0};
+        T mArray[SIZE + 1]{};
+        std::atomic_size_t mHead{0};
+    };
+
+    // Streams count sequential values from a producer thread to a consumer thread, verifying order, and returns
+    // the achieved rate in millions of elements per second.
+    template<typename QUEUE>
+    double measureTwoThreadThroughput(QUEUE &queue, uint64_t count, bool &inOrder) {
+        const auto start = std::chrono::steady_clock::now();
+        std::thread producer([&queue, count]() {
+            for(uint64_t i = 0; i < count; i++) {
+                while(!queue.push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        inOrder = true;
+        for(uint64_t expected = 0; expected < count; expected++) {
+            uint64_t value;
+            while(!queue.pop(value)) {
+                std::this_thread::yield();
+            }
+            inOrder = inOrder && (value == expected);
+        }
+        producer.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return (double)count / elapsed.count() / 1e6;
+    }
+}
+
+TEST_CASE( "CircularQueue two thread throughput") {
+    constexpr uint64_t NUM_ELEMENTS = 2'000'000;
+
+    static CircularQueue<uint64_t, 1024> queue;
+    bool inOrder = false;
+    const double spscRate = measureTwoThreadThroughput(queue, NUM_ELEMENTS, inOrder);
+    REQUIRE(inOrder);
+    REQUIRE(queue.empty());
+
+    static SeqCstReferenceQueue<uint64_t, 1024> reference;
+    const double referenceRate = measureTwoThreadThroughput(reference, NUM_ELEMENTS, inOrder);
+    REQUIRE(inOrder);
+
+    MESSAGE("CircularQueue SPSC: " << spscRate << " M elements/s, seq_cst reference: " << referenceRate
+            << " M elements/s (" << spscRate / referenceRate << "x)");
+}
+
+TEST_CASE( "CircularQueue bulk push and pop across the wrap point") {
+    CircularQueue<int, 8> queue;
+    const int first[]{1, 2, 3, 4, 5, 6};
+    REQUIRE(queue.push(first, std::size(first)));
+
+    //All or nothing pop leaves the queue untouched when there aren't enough elements.
+    int out[8]{};
+    REQUIRE_FALSE(queue.pop(nullptr, 1));
+    REQUIRE_FALSE(queue.pop(out, 7));
+    REQUIRE(queue.size() == 6);
+    REQUIRE(queue.pop(out, 4));
+    const int expected0[]{1, 2, 3, 4};
+    REQUIRE(memcmp(out, expected0, sizeof(expected0)) == 0);
+
+    //6 free slots, 2 before the end of storage and 4 after wrapping.  All or nothing push fails without
+    //modifying the queue.
+    const int second[]{7, 8, 9, 10, 11, 12, 13};
+    REQUIRE_FALSE(queue.push(second, std::size(second)));
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.push(second, 6));
+    REQUIRE(queue.full());
+
+    REQUIRE(queue.popUpTo(out, std::size(out)) == 8);
+    const int expected1[]{5, 6, 7, 8, 9, 10, 11, 12};
+    REQUIRE(memcmp(out, expected1, sizeof(expected1)) == 0);
+    REQUIRE(queue.empty());
+    REQUIRE(queue.popUpTo(out, std::size(out)) == 0);
+}
+
+TEST_CASE( "CircularQueue bulk push as many as fit") {
+    CircularQueue<uint8_t, 16> queue;
+    uint8_t burst[40];
+    for(size_t i = 0; i < std::size(burst); i++) {
+        burst[i] = (uint8_t)i;
+    }
+    REQUIRE(queue.pushUpTo(nullptr, 4) == 0);
+    REQUIRE(queue.pushUpTo(burst, 10) == 10);
+    REQUIRE(queue.pushUpTo(burst + 10, 30) == 6);
+    REQUIRE(queue.full());
+    REQUIRE(queue.pushUpTo(burst + 16, 24) == 0);
+
+    uint8_t out[40]{};
+    REQUIRE(queue.popUpTo(out, 12) == 12);
+    REQUIRE(queue.pushUpTo(burst + 16, 24) == 12);
+    REQUIRE(queue.popUpTo(out + 12, 28) == 16);
+    REQUIRE(memcmp(out, burst, 28) == 0);
+}
+
+TEST_CASE( "CircularQueue bulk operations with non trivially copyable elements") {
+    CircularQueue<std::string, 4> queue;
+    const std::string items[]{"one", "two", "three"};
+    REQUIRE(queue.push(items, 3));
+    std::string out[3];
+    REQUIRE(queue.pop(out, 2));
+    REQUIRE(queue.pushUpTo(items, 3) == 3);
+    REQUIRE(queue.popUpTo(out, 3) == 3);
+    REQUIRE(out[0] == "three");
+    REQUIRE(out[1] == "one");
+    REQUIRE(out[2] == "two");
+}
+
+TEST_CASE( "CircularQueue reserve and commit") {
+    CircularQueue<int, 8> queue;
+
+    //The whole storage is free and contiguous.
+    auto block = queue.reserveBlock();
+    REQUIRE(block.size() == 8);
+    REQUIRE(queue.reserveBlock(3).size() == 3);
+
+    //Nothing is visible until committed.
+    block[0] = 1;
+    block[1] = 2;
+    block[2] = 3;
+    REQUIRE(queue.empty());
+    REQUIRE(queue.commit(3));
+    REQUIRE(queue.size() == 3);
+    REQUIRE(queue.getBlock().size() == 3);
+
+    //Move the head and tail near the end of the storage so the free space wraps.
+    block = queue.reserveBlock();
+    REQUIRE(block.size() == 5);
+    std::fill(block.begin(), block.end(), 9);
+    REQUIRE(queue.commit(4));
+    REQUIRE(queue.popElements(6));
+    block = queue.reserveBlock();
+    REQUIRE(block.size() == 1);
+    block[0] = 10;
+    REQUIRE(queue.commit(1));
+    block = queue.reserveBlock();
+    REQUIRE(block.size() == 6);
+    block[0] = 11;
+    block[1] = 12;
+    REQUIRE_FALSE(queue.commit(7));
+    REQUIRE(queue.commit(2));
+
+    int out[4]{};
+    REQUIRE(queue.popUpTo(out, std::size(out)) == 4);
+    const int expected[]{9, 10, 11, 12};
+    REQUIRE(memcmp(out, expected, sizeof(expected)) == 0);
+
+    //A full queue has nothing to reserve.
+    const int fill[]{1, 2, 3, 4, 5, 6, 7, 8};
+    REQUIRE(queue.push(fill, 8));
+    REQUIRE(queue.reserveBlock().empty());
+    REQUIRE_FALSE(queue.commit(1));
+}
+
+TEST_CASE( "CircularQueue consume") {
+    CircularQueue<int, 8> queue;
+    const int items[]{1, 2, 3, 4, 5, 6};
+    REQUIRE(queue.push(items, 6));
+    REQUIRE(queue.popElements(4));
+    REQUIRE(queue.push(items, 6));
+
+    //Consume a limited number of elements, crossing the wrap point.
+    int got[8]{};
+    size_t n = 0;
+    REQUIRE(queue.consume([&](int &value) { got[n++] = value; }, 5) == 5);
+    const int expected0[]{5, 6, 1, 2, 3};
+    REQUIRE(memcmp(got, expected0, sizeof(expected0)) == 0);
+    REQUIRE(queue.size() == 3);
+
+    //Elements pushed from inside the callback aren't part of this drain.
+    n = 0;
+    REQUIRE(queue.consume_all([&](int &value) { got[n++] = value; queue.push(value * 10); }) == 3);
+    const int expected1[]{4, 5, 6};
+    REQUIRE(memcmp(got, expected1, sizeof(expected1)) == 0);
+    REQUIRE(queue.size() == 3);
+    REQUIRE(queue.consume_all([](int &) {}) == 3);
+    REQUIRE(queue.empty());
+    REQUIRE(queue.consume_all([](int &) {}) == 0);
+}
+
+TEST_CASE( "CircularQueue consume publishes processed elements when the callback throws") {
+    CircularQueue<int, 4> queue = {1, 2, 3, 4};
+    REQUIRE_THROWS_AS(queue.consume_all([](int &value) {
+        if(value == 3) {
+            throw std::runtime_error("bad element");
+        }
+    }), std::runtime_error);
+    REQUIRE(queue.size() == 2);
+    int value;
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 3);
+}
+
+namespace {
+    // Counts live instances so tests can check exactly which elements the queue has constructed and destroyed.
+    struct Tracked {
+        static inline int sLive = 0;
+        static inline int sConstructed = 0;
+        int mValue;
+
+        explicit Tracked(int value = 0): mValue(value) { sLive++; sConstructed++; }
+        Tracked(const Tracked &rhs): mValue(rhs.mValue) { sLive++; sConstructed++; }
+        Tracked(Tracked &&rhs) noexcept: mValue(rhs.mValue) { sLive++; sConstructed++; }
+        Tracked &operator=(const Tracked &rhs) = default;
+        Tracked &operator=(Tracked &&rhs) noexcept = default;
+        ~Tracked() { sLive--; }
+    };
+}
+
+TEST_CASE( "CircularQueue constructs elements only when pushed") {
+    Tracked::sLive = 0;
+    Tracked::sConstructed = 0;
+    {
+        CircularQueue<Tracked, 64> queue;
+        REQUIRE(Tracked::sConstructed == 0);
+
+        REQUIRE(queue.emplace(1));
+        REQUIRE(queue.push(Tracked(2)));
+        const Tracked three(3);
+        REQUIRE(queue.push(three));
+        REQUIRE(Tracked::sLive == 4);   // three elements in the queue and the local
+
+        Tracked out;
+        REQUIRE(queue.pop(out));
+        REQUIRE(out.mValue == 1);
+        REQUIRE(Tracked::sLive == 4);   // popped element destroyed, out added
+
+        REQUIRE(queue.popElements(1));
+        REQUIRE(Tracked::sLive == 3);
+
+        //Elements are destroyed after the consume callback.
+        REQUIRE(queue.emplace(4));
+        REQUIRE(queue.consume_all([](Tracked &) {}) == 2);
+        REQUIRE(Tracked::sLive == 2);
+
+        //clear() and the destructor destroy what is left.
+        REQUIRE(queue.emplace(5));
+        REQUIRE(queue.emplace(6));
+        queue.clear();
+        REQUIRE(Tracked::sLive == 2);
+        REQUIRE(queue.emplace(7));
+        REQUIRE(Tracked::sLive == 3);
+    }
+    REQUIRE(Tracked::sLive == 0);
+}
+
+TEST_CASE( "CircularQueue move only elements") {
+    CircularQueue<std::unique_ptr<int>, 4> queue;
+    REQUIRE(queue.push(std::make_unique<int>(1)));
+    REQUIRE(queue.emplace(new int(2)));
+    REQUIRE(queue.emplace(std::make_unique<int>(3)));
+
+    //The Queue<T> functions that need a copy (push(const T&), push(const T*, size_t), peek()) don't exist.
+    static_assert(!QueueType<decltype(queue)>);
+
+    auto first = queue.pop();
+    REQUIRE(first);
+    REQUIRE(**first == 1);
+
+    std::unique_ptr<int> second;
+    REQUIRE(queue.pop(second));
+    REQUIRE(*second == 2);
+
+    std::unique_ptr<int> rest[2];
+    REQUIRE(queue.emplace(std::make_unique<int>(4)));
+    REQUIRE(queue.popUpTo(rest, 2) == 2);
+    REQUIRE(*rest[0] == 3);
+    REQUIRE(*rest[1] == 4);
+    REQUIRE_FALSE(queue.pop());
+}
+
+TEST_CASE( "CircularQueue of a million slots constructs nothing") {
+    Tracked::sConstructed = 0;
+    auto queue = std::make_unique<CircularQueue<Tracked, 1'000'000>>();
+    REQUIRE(Tracked::sConstructed == 0);
+    REQUIRE(queue->empty());
+    REQUIRE(queue->capacity() == 1'000'000);
+}
@@ -0,0 +1,162 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/AsyncCircularQueue.h"
+#include "../Collections/BlockingCircularQueue.h"
+#include "../Collections/CircularQueue.h"
+#include "../Collections/List.h"
+#include "../Collections/OverwriteCircularQueue.h"
+#include "../Collections/Queue.h"
+#include "../Collections/SmallVector.h"
+#include "../Collections/StaticLinkedList.h"
+#include "../Collections/StaticMPMCQueue.h"
+#include "../Collections/StaticPriorityQueue.h"
+#include "../Collections/StaticVector.h"
+#include "doctest.h"
+
+#include <chrono>
+#include <type_traits>
+
+static_assert(QueueType<CircularQueue<int, 4>>);
+static_assert(QueueType<BlockingCircularQueue<int, 4>>);
+static_assert(QueueType<AsyncCircularQueue<int, 4>>);
+static_assert(QueueType<OverwriteCircularQueue<int, 4>>);
+static_assert(QueueType<StaticMPMCQueue<int, 4>>);
+static_assert(QueueType<StaticPriorityQueue<int, 4>>);
+static_assert(ListType<LinkedList<int>>);
+static_assert(ListType<StaticLinkedList<int, 4>>);
+static_assert(VectorType<StaticVector<int, 4>>);
+static_assert(VectorType<SmallVector<int, 4>>);
+
+static_assert(!std::is_polymorphic_v<CircularQueue<int, 4>>);
+static_assert(!std::is_polymorphic_v<StaticVector<int, 4>>);
+static_assert(!std::is_polymorphic_v<StaticLinkedList<int, 4>>);
+static_assert(std::is_final_v<CircularQueue<int, 4>> && std::is_final_v<StaticVector<int, 4>> &&
+              std::is_final_v<StaticLinkedList<int, 4>>);
+
+TEST_CASE("Queue refers to queues of any type and size") {
+    CircularQueue<int, 2> circular;
+    StaticMPMCQueue<int, 8> mpmc;
+    StaticPriorityQueue<int, 4> priority;
+    Queue<int> queues[]{circular, mpmc, priority};
+
+    for(auto &queue: queues) {
+        REQUIRE(queue.empty());
+        REQUIRE(queue.push(1));
+        REQUIRE(queue.push(2));
+    }
+    REQUIRE(queues[0].full());
+    REQUIRE(queues[1].capacity() == 8);
+    REQUIRE(mpmc.size() == 2);
+
+    int value;
+    REQUIRE(queues[0].pop(value));
+    REQUIRE(value == 1);
+    REQUIRE(queues[2].peek(value));
+    REQUIRE(value == 2);    // highest priority first
+    queues[1].clear();
+    REQUIRE(mpmc.empty());
+}
+
+TEST_CASE("List refers to any list") {
+    StaticLinkedList<int, 4> list{1, 2};
+    List<int> ref = list;
+    ref.push_front(0);
+    ref.push_back(3);
+    REQUIRE(ref.size() == 4);
+    REQUIRE(ref.isFull());
+    REQUIRE(ref.front() == 0);
+    REQUIRE(ref.back() == 3);
+    ref.erase(2);
+    ref.eraseAtIndex(0);
+    REQUIRE(list.front() == 1);
+    REQUIRE(list.back() == 3);
+    ref.clear();
+    REQUIRE(list.empty());
+}
+
+namespace {
+    // The interfaces the containers used to derive from, to time a call through a vtable.
+    struct VirtualVector {
+        virtual bool push_back(const int &elem) = 0;
+        virtual void pop_back() = 0;
+    };
+    struct VirtualList {
+        virtual void push_back(const int &elem) = 0;
+        virtual void pop_front() = 0;
+    };
+    struct VirtualQueue {
+        virtual bool push(const int &item) = 0;
+        virtual bool pop(int &item) = 0;
+    };
+
+    struct VectorAdapter final: VirtualVector {
+        StaticVector<int, 64> mVector;
+        bool push_back(const int &elem) override { return mVector.push_back(elem); }
+        void pop_back() override { mVector.pop_back(); }
+    };
+    struct ListAdapter final: VirtualList {
+        StaticLinkedList<int, 64> mList;
+        void push_back(const int &elem) override { mList.push_back(elem); }
+        void pop_front() override { mList.pop_front(); }
+    };
+    struct QueueAdapter final: VirtualQueue {
+        CircularQueue<int, 64> mQueue;
+        bool push(const int &item) override { return mQueue.push(item); }
+        bool pop(int &item) override { return mQueue.pop(item); }
+    };
+
+    // Hides the dynamic type from the optimizer, as a reference passed in from elsewhere would.
+    template<typename T>
+    T *opaque(T *pointer) {
+#if defined(__GNUC__)
+        asm volatile("" : "+r"(pointer));
+#endif
+        return pointer;
+    }
+
+    // Nanoseconds per operation of body, which performs two operations per iteration.
+    template<typename BODY>
+    double timePerCall(BODY body) {
+        constexpr int iterations = 2000000;
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iterations; i++) {
+            body(i);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / (2.0 * iterations);
+    }
+}
+
+TEST_CASE("Direct calls compared with virtual dispatch") {
+    int sink = 0;
+
+    VectorAdapter vectorAdapter;
+    VirtualVector *virtualVector = opaque<VirtualVector>(&vectorAdapter);
+    auto *vector = opaque(&vectorAdapter.mVector);
+    const double vectorVirtual = timePerCall([&](int i) { virtualVector->push_back(i); virtualVector->pop_back(); });
+    const double vectorDirect = timePerCall([&](int i) { vector->push_back(i); vector->pop_back(); });
+
+    ListAdapter listAdapter;
+    VirtualList *virtualList = opaque<VirtualList>(&listAdapter);
+    auto *list = opaque(&listAdapter.mList);
+    const double listVirtual = timePerCall([&](int i) { virtualList->push_back(i); virtualList->pop_front(); });
+    const double listDirect = timePerCall([&](int i) { list->push_back(i); list->pop_front(); });
+
+    QueueAdapter queueAdapter;
+    VirtualQueue *virtualQueue = opaque<VirtualQueue>(&queueAdapter);
+    auto *queue = opaque(&queueAdapter.mQueue);
+    Queue<int> erased = *queue;
+    const double queueVirtual = timePerCall([&](int i) { virtualQueue->push(i); virtualQueue->pop(sink); });
+    const double queueDirect = timePerCall([&](int i) { queue->push(i); queue->pop(sink); });
+    const double queueErased = timePerCall([&](int i) { erased.push(i); erased.pop(sink); });
+
+    REQUIRE(vector->empty());
+    REQUIRE(list->empty());
+    REQUIRE(queue->empty());
+    REQUIRE(sink == 1999999);
+    MESSAGE("ns per call, virtual vs direct: StaticVector " << vectorVirtual << " vs " << vectorDirect
+            << ", StaticLinkedList " << listVirtual << " vs " << listDirect << ", CircularQueue " << queueVirtual
+            << " vs " << queueDirect << " (type erased Queue " << queueErased << ")");
+}
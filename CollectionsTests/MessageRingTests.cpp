@@ -0,0 +1,192 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/MessageRing.h"
+#include "doctest.h"
+
+#include <cstring>
+#include <numeric>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::span<const uint8_t> bytes(std::string_view text) {
+        return {(const uint8_t *)text.data(), text.size()};
+    }
+
+    std::string_view text(std::span<const uint8_t> message) {
+        return {(const char *)message.data(), message.size()};
+    }
+}
+
+TEST_CASE("MessageRing reads back whole messages") {
+    MessageRing<64> ring;
+    REQUIRE(ring.empty());
+    REQUIRE_FALSE(ring.tryRead());
+
+    REQUIRE(ring.tryWrite(bytes("hello")));
+    REQUIRE(ring.tryWrite(bytes("")));
+    REQUIRE(ring.tryWrite(bytes("variable length")));
+
+    auto message = ring.tryRead();
+    REQUIRE(message);
+    REQUIRE(text(*message) == "hello");
+    REQUIRE((uintptr_t)message->data() % MessageRing<64>::ALIGNMENT == 0);
+
+    //Reading again without releasing returns the same message.
+    REQUIRE(text(*ring.tryRead()) == "hello");
+    ring.release();
+
+    message = ring.tryRead();
+    REQUIRE(message);
+    REQUIRE(message->empty());
+    ring.release();
+
+    message = ring.tryRead();
+    REQUIRE(message);
+    REQUIRE(text(*message) == "variable length");
+    ring.release();
+    REQUIRE(ring.empty());
+    REQUIRE_FALSE(ring.tryRead());
+}
+
+TEST_CASE("MessageRing rejects messages that don't fit") {
+    MessageRing<64> ring;
+    std::vector<uint8_t> big(MessageRing<64>::MAX_MESSAGE_SIZE + 1);
+    REQUIRE_FALSE(ring.tryWrite(big));
+    big.pop_back();
+    REQUIRE(ring.tryWrite(big));
+    REQUIRE_FALSE(ring.tryWrite(bytes("x")));
+    REQUIRE(ring.tryRead()->size() == MessageRing<64>::MAX_MESSAGE_SIZE);
+}
+
+TEST_CASE("MessageRing skips to the start of the storage instead of splitting a message") {
+    MessageRing<64> ring;
+    //Each 20 byte message takes a 32 byte record.
+    const std::string_view first(  "aaaaaaaaaaaaaaaaaaaa");
+    const std::string_view second( "bbbbbbbbbbbbbbbbbbbb");
+    const std::string_view third(  "cccccccccccccccccccc");
+    const std::string_view fourth( "dddd");
+    REQUIRE(ring.tryWrite(bytes(first)));
+    REQUIRE(ring.tryWrite(bytes(fourth)));      // 16 byte record, 16 bytes left before the wrap point
+    REQUIRE(ring.tryRead());
+    ring.release();                             // 32 bytes free at the start
+
+    //Doesn't fit in the 16 bytes before the wrap point, so it's written at the start.
+    REQUIRE(ring.tryWrite(bytes(second)));
+    //Nothing left: the skipped 16 bytes are only reclaimed once read past.
+    REQUIRE_FALSE(ring.tryWrite(bytes(third)));
+
+    REQUIRE(text(*ring.tryRead()) == fourth);
+    ring.release();
+    REQUIRE(text(*ring.tryRead()) == second);
+    ring.release();
+    REQUIRE(ring.empty());
+
+    REQUIRE(ring.tryWrite(bytes(third)));
+    REQUIRE(text(*ring.tryRead()) == third);
+}
+
+TEST_CASE("MessageRing streams variable length messages between two threads") {
+    constexpr uint32_t NUM_MESSAGES = 100'000;
+    static MessageRing<4096> ring;
+
+    std::thread producer([]() {
+        uint8_t payload[300];
+        for(uint32_t i = 0; i < NUM_MESSAGES; i++) {
+            //Length and content derived from the sequence number so the consumer can verify them.
+            const size_t length = sizeof(i) + (i * 7919) % (sizeof(payload) - sizeof(i));
+            std::memcpy(payload, &i, sizeof(i));
+            std::fill(payload + sizeof(i), payload + length, (uint8_t)i);
+            while(!ring.tryWrite({payload, length})) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    bool valid = true;
+    for(uint32_t expected = 0; expected < NUM_MESSAGES;) {
+        const auto message = ring.tryRead();
+        if(!message) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t sequence;
+        std::memcpy(&sequence, message->data(), sizeof(sequence));
+        const size_t length = sizeof(sequence) + (expected * 7919) % (300 - sizeof(sequence));
+        valid = valid && sequence == expected && message->size() == length &&
+                std::all_of(message->begin() + sizeof(sequence), message->end(),
+                            [expected](uint8_t b) { return b == (uint8_t)expected; });
+        ring.release();
+        expected++;
+    }
+    producer.join();
+    REQUIRE(valid);
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("MessageRing wraps once the consumer has released enough") {
+    MessageRing<64> ring;
+    REQUIRE(ring.tryWrite(bytes("aaaaaaaaaaaaaaaaaaaa")));     // 32 byte record
+    REQUIRE(ring.tryWrite(bytes("bbbb")));                     // 16 byte record, 16 bytes left before the wrap point
+    //Skipping the 16 bytes before the wrap point would leave nothing at the start.
+    REQUIRE_FALSE(ring.tryWrite(bytes("cccccccccccccccccccc")));
+    REQUIRE(ring.tryRead());
+    ring.release();
+    REQUIRE(ring.tryWrite(bytes("cccccccccccccccccccc")));
+    REQUIRE(text(*ring.tryRead()) == "bbbb");
+    ring.release();
+    //The skip record is popped by its own length.
+    REQUIRE(text(*ring.tryRead()) == "cccccccccccccccccccc");
+    ring.release();
+    REQUIRE(ring.empty());
+
+    //Records that end exactly at the wrap point need no skip.
+    REQUIRE(ring.tryWrite(bytes("dddddddd")));
+    REQUIRE(ring.tryWrite(bytes("eeeeeeee")));
+    REQUIRE(text(*ring.tryRead()) == "dddddddd");
+    ring.release();
+    REQUIRE(text(*ring.tryRead()) == "eeeeeeee");
+    ring.release();
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("MessageRing wraps while the consumer releases between the producer's reserves") {
+    //A ring only a few records long wraps every few messages, so the consumer often frees space between the reserve
+    //that finds the wrap point and the one after the skip record.
+    constexpr uint32_t NUM_MESSAGES = 200'000;
+    static MessageRing<64> ring;
+
+    std::thread producer([]() {
+        uint8_t payload[24];    // records of at most half the ring, which always fit once it drains
+        for(uint32_t i = 0; i < NUM_MESSAGES; i++) {
+            const size_t length = sizeof(i) + (i * 31) % (sizeof(payload) - sizeof(i));
+            std::memcpy(payload, &i, sizeof(i));
+            std::fill(payload + sizeof(i), payload + length, (uint8_t)i);
+            while(!ring.tryWrite({payload, length})) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    bool valid = true;
+    for(uint32_t expected = 0; expected < NUM_MESSAGES;) {
+        const auto message = ring.tryRead();
+        if(!message) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t sequence;
+        std::memcpy(&sequence, message->data(), sizeof(sequence));
+        valid = valid && sequence == expected && message->size() == sizeof(sequence) + (expected * 31) % 20 &&
+                std::all_of(message->begin() + sizeof(sequence), message->end(),
+                            [expected](uint8_t b) { return b == (uint8_t)expected; });
+        ring.release();
+        expected++;
+    }
+    producer.join();
+    REQUIRE(valid);
+    REQUIRE(ring.empty());
+}
@@ -0,0 +1,122 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/MirroredCircularQueue.h"
+#include "../Collections/CircularQueue.h"
+#include "doctest.h"
+
+#include <cstring>
+#include <numeric>
+#include <thread>
+
+#if defined(__linux__)
+
+TEST_CASE("MirroredCircularQueue is created") {
+    MirroredCircularQueue<uint8_t, 4096> queue;
+    REQUIRE(queue.empty());
+    REQUIRE(queue.capacity() == 4096);
+    REQUIRE(queue.reserveBlock().size() == 4096);
+
+    MirroredCircularQueue<int, 1024> initialized = {1, 2, 3};
+    REQUIRE(initialized.size() == 3);
+
+    //Storage must be a whole number of pages.
+    REQUIRE_THROWS_AS((MirroredCircularQueue<uint8_t, 100>()), std::invalid_argument);
+}
+
+TEST_CASE("MirroredCircularQueue blocks are contiguous across the wrap point") {
+    MirroredCircularQueue<uint8_t, 4096> queue;
+    uint8_t data[3000];
+    std::iota(std::begin(data), std::end(data), 0);
+
+    REQUIRE(queue.push(data, 3000));
+    REQUIRE(queue.popElements(3000));
+
+    //The free space now starts 3000 bytes into the storage and wraps, but is still one span.
+    const auto block = queue.reserveBlock();
+    REQUIRE(block.size() == 4096);
+    std::memcpy(block.data(), data, 2500);
+    REQUIRE(queue.commit(2500));
+
+    //The data wrapped in the physical storage but reads back as a single block.
+    const auto readable = queue.getBlock();
+    REQUIRE(readable.size() == 2500);
+    REQUIRE(std::memcmp(readable.data(), data, 2500) == 0);
+
+    uint8_t out[2500];
+    REQUIRE(queue.pop(out, 2500));
+    REQUIRE(std::memcmp(out, data, 2500) == 0);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("MirroredCircularQueue matches the CircularQueue API") {
+    //Code written against one queue type compiles and behaves the same with the other.
+    auto exercise = [](auto &queue) {
+        const int items[]{1, 2, 3, 4, 5};
+        REQUIRE(queue.push(items, 5));
+        int value;
+        REQUIRE(queue.peek(value));
+        REQUIRE(value == 1);
+        REQUIRE(queue.pop(value));
+        REQUIRE(queue.pushUpTo(items, 5) == 5);
+        int sum = 0;
+        REQUIRE(queue.consume([&sum](int &v) { sum += v; }, 4) == 4);
+        REQUIRE(sum == 2 + 3 + 4 + 5);
+        int out[5];
+        REQUIRE(queue.popUpTo(out, 5) == 5);
+        REQUIRE(queue.empty());
+        const auto block = queue.reserveBlock(1);
+        REQUIRE(block.size() == 1);
+        block[0] = 9;
+        REQUIRE(queue.commit(1));
+        REQUIRE(queue.getBlock()[0] == 9);
+        REQUIRE(queue.consume_all([](int &) {}) == 1);
+
+        REQUIRE(queue.emplace(7));
+        REQUIRE(queue.push(8));
+        REQUIRE(queue.pop() == 7);
+        REQUIRE(queue.pop() == 8);
+        REQUIRE_FALSE(queue.pop());
+    };
+
+    MirroredCircularQueue<int, 1024> mirrored;
+    exercise(mirrored);
+    CircularQueue<int, 1024> circular;
+    exercise(circular);
+}
+
+TEST_CASE("MirroredCircularQueue streams between two threads") {
+    constexpr uint32_t NUM_ELEMENTS = 1'000'000;
+    MirroredCircularQueue<uint32_t, 1024> queue;
+    std::thread producer([&queue]() {
+        uint32_t next = 0;
+        while(next < NUM_ELEMENTS) {
+            const auto block = queue.reserveBlock(NUM_ELEMENTS - next);
+            for(auto &slot: block) {
+                slot = next++;
+            }
+            queue.commit(block.size());
+            if(block.empty()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool inOrder = true;
+    while(expected < NUM_ELEMENTS) {
+        const auto block = queue.getBlock();
+        for(const auto value: block) {
+            inOrder = inOrder && value == expected++;
+        }
+        queue.popElements(block.size());
+        if(block.empty()) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    REQUIRE(inOrder);
+}
+
+#endif //defined(__linux__)
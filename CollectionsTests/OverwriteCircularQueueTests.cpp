@@ -0,0 +1,98 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/OverwriteCircularQueue.h"
+#include "doctest.h"
+
+#include <thread>
+
+TEST_CASE("OverwriteCircularQueue behaves like a queue until it fills") {
+    OverwriteCircularQueue<int, 4> queue = {1, 2, 3};
+    REQUIRE(queue.size() == 3);
+    REQUIRE(queue.capacity() == 4);
+    REQUIRE(queue.push(4));
+    REQUIRE(queue.full());
+
+    int value;
+    REQUIRE(queue.peek(value));
+    REQUIRE(value == 1);
+    for(int expected = 1; expected <= 4; expected++) {
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == expected);
+    }
+    REQUIRE_FALSE(queue.pop(value));
+    REQUIRE(queue.empty());
+    REQUIRE(queue.overwritten() == 0);
+}
+
+TEST_CASE("OverwriteCircularQueue keeps the newest elements") {
+    OverwriteCircularQueue<int, 4> queue;
+    for(int i = 0; i < 10; i++) {
+        REQUIRE(queue.push(i));
+    }
+    REQUIRE(queue.size() == 4);
+    REQUIRE(queue.full());
+
+    int out[4];
+    REQUIRE(queue.pop(out, 4));
+    const int expected[]{6, 7, 8, 9};
+    REQUIRE(std::equal(std::begin(out), std::end(out), std::begin(expected)));
+    REQUIRE(queue.overwritten() == 6);
+    REQUIRE(queue.empty());
+
+    //Overruns are detected again after the consumer has caught up.
+    const int burst[]{10, 11, 12, 13, 14, 15};
+    REQUIRE(queue.push(burst, 6));
+    REQUIRE(queue.popElements(1));
+    REQUIRE(queue.overwritten() == 8);
+    int value;
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 13);
+
+    //A bulk push larger than the queue only keeps its last SIZE items.
+    const int big[]{20, 21, 22, 23, 24, 25, 26};
+    REQUIRE(queue.push(big, 7));
+    REQUIRE_FALSE(queue.pop(out, 5));
+    REQUIRE(queue.pop(out, 4));
+    const int expectedBig[]{23, 24, 25, 26};
+    REQUIRE(std::equal(std::begin(out), std::end(out), std::begin(expectedBig)));
+    REQUIRE(queue.overwritten() == 8 + 2 + 3);
+}
+
+TEST_CASE("OverwriteCircularQueue producer never blocks a slow consumer") {
+    constexpr uint64_t NUM_ELEMENTS = 1'000'000;
+    static OverwriteCircularQueue<uint64_t, 64> queue;
+    std::atomic_bool done{false};
+
+    std::thread producer([&done]() {
+        for(uint64_t i = 0; i < NUM_ELEMENTS; i++) {
+            queue.push(i);
+        }
+        done = true;
+    });
+
+    //Every element is either received, in order, or counted as overwritten.
+    uint64_t received = 0;
+    uint64_t last = 0;
+    bool increasing = true;
+    for(;;) {
+        const bool finished = done;
+        uint64_t value;
+        while(queue.pop(value)) {
+            increasing = increasing && (received == 0 || value > last);
+            last = value;
+            received++;
+        }
+        if(finished) {
+            break;
+        }
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    REQUIRE(increasing);
+    REQUIRE(last == NUM_ELEMENTS - 1);
+    REQUIRE(received + queue.overwritten() == NUM_ELEMENTS);
+    MESSAGE("received " << received << ", overwritten " << queue.overwritten());
+}
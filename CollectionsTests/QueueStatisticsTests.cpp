@@ -0,0 +1,106 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/CircularQueue.h"
+#include "../Collections/QueueStatistics.h"
+#include "doctest.h"
+
+#include <cstdint>
+#include <thread>
+
+TEST_CASE("CircularQueue without statistics pays nothing for them") {
+    static_assert(std::is_empty_v<NoQueueStatistics>);
+    // producer line, consumer line, storage line
+    static_assert(sizeof(CircularQueue<std::uint8_t, CACHE_LINE_SIZE>) == 3 * CACHE_LINE_SIZE);
+    static_assert(sizeof(CircularQueue<std::uint8_t, CACHE_LINE_SIZE, QueueStatistics<>>) >
+                  sizeof(CircularQueue<std::uint8_t, CACHE_LINE_SIZE>));
+}
+
+TEST_CASE("CircularQueue statistics count pushes and pops") {
+    CircularQueue<int, 4, QueueStatistics<>> queue;
+    const auto &stats = queue.statistics();
+
+    int value;
+    REQUIRE_FALSE(queue.pop(value));
+    REQUIRE_FALSE(queue.pop().has_value());
+    REQUIRE(stats.popEmptyCount() == 2);
+
+    for(int i = 0; i < 4; i++) {
+        REQUIRE(queue.push(i));
+    }
+    REQUIRE_FALSE(queue.push(4));
+    const int items[]{5, 6};
+    REQUIRE_FALSE(queue.push(items, 2));
+    REQUIRE(stats.pushFullCount() == 2);
+    REQUIRE(stats.enqueued() == 4);
+    REQUIRE(stats.highWaterMark() == 4);
+
+    int out[4];
+    REQUIRE(queue.pop(out, 3));
+    REQUIRE(queue.popUpTo(out, 4) == 1);
+    REQUIRE(stats.dequeued() == 4);
+    REQUIRE(stats.popEmptyCount() == 3);
+
+    REQUIRE(queue.pushUpTo(items, 2) == 2);
+    REQUIRE(queue.consume_all([](int &) {}) == 2);
+    REQUIRE(queue.emplace(7));
+    REQUIRE(queue.popElements(1));
+    auto block = queue.reserveBlock(3);
+    REQUIRE(block.size() == 1);     // up to the end of the storage
+    REQUIRE(queue.commit(1));
+    REQUIRE(stats.enqueued() == 8);
+    REQUIRE(stats.dequeued() == 7);
+    REQUIRE(stats.highWaterMark() == 4);
+}
+
+TEST_CASE("CircularQueue statistics histogram of sizes at push") {
+    CircularQueue<int, 8, QueueStatistics<4>> queue;
+    for(int i = 0; i < 8; i++) {
+        REQUIRE(queue.push(i));
+    }
+    // sizes 0..7 at push, two per quarter of the capacity
+    const auto histogram = queue.statistics().histogram();
+    REQUIRE(histogram.size() == 4);
+    for(auto bucket: histogram) {
+        REQUIRE(bucket == 2);
+    }
+}
+
+TEST_CASE("CircularQueue statistics agree across threads") {
+    constexpr int count = 100000;
+    CircularQueue<int, 64, QueueStatistics<8>> queue;
+
+    std::thread producer([&queue]() {
+        for(int i = 0; i < count;) {
+            if(queue.push(i)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int received = 0;
+    while(received < count) {
+        int value;
+        if(queue.pop(value)) {
+            REQUIRE(value == received);
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    const auto &stats = queue.statistics();
+    REQUIRE(stats.enqueued() == count);
+    REQUIRE(stats.dequeued() == count);
+    REQUIRE(stats.highWaterMark() <= 64);
+    std::uint64_t pushes = 0;
+    for(auto bucket: stats.histogram()) {
+        pushes += bucket;
+    }
+    REQUIRE(pushes == count);
+    MESSAGE("push full " << stats.pushFullCount() << ", pop empty " << stats.popEmptyCount() << ", high water "
+                         << stats.highWaterMark());
+}
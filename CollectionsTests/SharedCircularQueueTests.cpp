@@ -0,0 +1,152 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/SharedCircularQueue.h"
+#include "doctest.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+
+namespace {
+    std::string segmentName(const char *test) {
+        return std::string("/StaticCollections-") + test + "-" + std::to_string(getpid());
+    }
+}
+
+TEST_CASE("SharedCircularQueue create and attach") {
+    using SharedQueue = SharedCircularQueue<uint32_t, 1024>;
+    const auto name = segmentName("attach");
+    {
+        SharedMemorySegment producerView(name.c_str(), sizeof(SharedQueue), true);
+        SharedMemorySegment consumerView(name.c_str(), sizeof(SharedQueue), false);
+        REQUIRE(producerView.data() != consumerView.data());
+
+        //Zeroed memory was never initialized by create().
+        REQUIRE_THROWS_AS(SharedQueue::attach(consumerView.data(), consumerView.size()), std::runtime_error);
+        REQUIRE_THROWS_AS(SharedQueue::create(producerView.data(), 16), std::invalid_argument);
+
+        auto *producer = SharedQueue::create(producerView.data(), producerView.size());
+        auto *consumer = SharedQueue::attach(consumerView.data(), consumerView.size());
+        REQUIRE(consumer->empty());
+        REQUIRE(consumer->capacity() == 1024);
+
+        //A queue with a different element type or capacity can't attach.
+        REQUIRE_THROWS_AS((SharedCircularQueue<uint32_t, 512>::attach(consumerView.data(), consumerView.size())),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS((SharedCircularQueue<uint16_t, 1024>::attach(consumerView.data(), consumerView.size())),
+                          std::runtime_error);
+
+        //Elements pushed through one mapping are popped through the other.
+        uint32_t items[1000];
+        std::iota(std::begin(items), std::end(items), 0);
+        REQUIRE(producer->push(items, 1000));
+        REQUIRE(consumer->size() == 1000);
+        uint32_t out[1000];
+        REQUIRE(consumer->pop(out, 600));
+        REQUIRE(std::memcmp(out, items, 600 * sizeof(uint32_t)) == 0);
+
+        //Wrap the storage.  The first block runs to the end of the storage: the 400 remaining elements of the first
+        //push followed by the first 24 of the second.
+        REQUIRE(producer->pushUpTo(items, 1000) == 624);
+        REQUIRE(producer->full());
+        REQUIRE(consumer->getBlock().size() == 424);
+        REQUIRE(consumer->popElements(424));
+        REQUIRE(consumer->popUpTo(out, 1000) == 600);
+        REQUIRE(std::memcmp(out, items + 24, 600 * sizeof(uint32_t)) == 0);
+
+        REQUIRE(producer->emplace(5u));
+        REQUIRE(consumer->pop() == 5u);
+        REQUIRE_FALSE(consumer->pop());
+
+        //consume() runs across the wrap point.
+        REQUIRE(producer->push(items, 1000));
+        uint32_t sum = 0;
+        REQUIRE(consumer->consume([&sum](uint32_t &v) { sum += v; }, 10) == 10);
+        REQUIRE(sum == 45);
+        REQUIRE(consumer->consume_all([](uint32_t &) {}) == 990);
+        producer->clear();
+        REQUIRE(consumer->empty());
+    }
+    SharedMemorySegment::unlink(name.c_str());
+}
+
+TEST_CASE("SharedCircularQueue between two processes") {
+    using SharedQueue = SharedCircularQueue<uint64_t, 256>;
+    constexpr uint64_t NUM_ELEMENTS = 200'000;
+    //Neither side spins forever if the other one dies or stalls.
+    constexpr auto TIMEOUT = std::chrono::seconds(30);
+    const auto name = segmentName("processes");
+
+    SharedMemorySegment segment(name.c_str(), sizeof(SharedQueue), true);
+    SharedQueue::create(segment.data(), segment.size());
+
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if(child == 0) {
+        //Producer process with its own mapping of the segment.  Exits with 0 once everything is pushed, 1 if it
+        //timed out and 2 if it couldn't attach; _exit skips the parent's atexit handlers and doctest's reporting.
+        int status = 1;
+        try {
+            SharedMemorySegment view(name.c_str(), sizeof(SharedQueue), false);
+            auto *queue = SharedQueue::attach(view.data(), view.size());
+            const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+            uint64_t i = 0;
+            while(i < NUM_ELEMENTS && std::chrono::steady_clock::now() < deadline) {
+                const auto block = queue->reserveBlock(NUM_ELEMENTS - i);
+                if(block.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for(auto &slot: block) {
+                    slot = i++;
+                }
+                queue->commit(block.size());
+            }
+            status = i == NUM_ELEMENTS ? 0 : 1;
+        } catch(...) {
+            status = 2;
+        }
+        _exit(status);
+    }
+
+    auto *queue = SharedQueue::attach(segment.data(), segment.size());
+    const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    bool inOrder = true;
+    uint64_t expected = 0;
+    while(expected < NUM_ELEMENTS && std::chrono::steady_clock::now() < deadline) {
+        uint64_t value;
+        if(queue->pop(value)) {
+            inOrder = inOrder && value == expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    //Reap the child, killing it if it hasn't finished by the deadline.
+    int status = 0;
+    pid_t reaped;
+    while((reaped = waitpid(child, &status, WNOHANG)) == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if(reaped == 0) {
+        kill(child, SIGKILL);
+        reaped = waitpid(child, &status, 0);
+    }
+    SharedMemorySegment::unlink(name.c_str());
+
+    REQUIRE(expected == NUM_ELEMENTS);
+    REQUIRE(inOrder);
+    REQUIRE(reaped == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+}
+
+#endif //defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,157 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/SmallVector.h"
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+
+namespace {
+    // Passes allocations through to an upstream resource, counting them.
+    class CountingResource: public std::pmr::memory_resource {
+    public:
+        explicit CountingResource(std::pmr::memory_resource &upstream): mUpstream(upstream) {}
+
+        int allocations = 0;
+        int deallocations = 0;
+
+    private:
+        void *do_allocate(size_t size, size_t alignment) override {
+            allocations++;
+            return mUpstream.allocate(size, alignment);
+        }
+        void do_deallocate(void *p, size_t size, size_t alignment) override {
+            deallocations++;
+            mUpstream.deallocate(p, size, alignment);
+        }
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+
+        std::pmr::memory_resource &mUpstream;
+    };
+}
+
+TEST_CASE("SmallVector keeps N elements inline") {
+    CountingResource resource(*std::pmr::new_delete_resource());
+    {
+        SmallVector<int, 8> v(resource);
+        REQUIRE(v.capacity() == 8);
+        for(int i = 0; i < 8; i++) {
+            REQUIRE(v.push_back(i));
+        }
+        REQUIRE(v.isInline());
+        REQUIRE(resource.allocations == 0);
+
+        REQUIRE(v.push_back(8));
+        REQUIRE_FALSE(v.isInline());
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(v.capacity() == 16);
+        REQUIRE(v.size() == 9);
+        REQUIRE(std::accumulate(v.begin(), v.end(), 0) == 36);
+
+        for(int i = 9; i < 300; i++) {
+            REQUIRE(v.push_back(i));
+        }
+        REQUIRE(v.capacity() == 512);
+        REQUIRE(resource.allocations == 6);     // 16, 32, 64, 128, 256, 512
+        REQUIRE(resource.deallocations == 5);
+        REQUIRE(v[299] == 299);
+
+        v.clear();
+        REQUIRE(v.capacity() == 512);           // keeps its buffer
+    }
+    REQUIRE(resource.deallocations == 6);
+}
+
+TEST_CASE("SmallVector spills into an arena") {
+    std::byte arenaBuffer[4096];
+    std::pmr::monotonic_buffer_resource arena(arenaBuffer, sizeof(arenaBuffer), std::pmr::null_memory_resource());
+    CountingResource resource(arena);
+
+    SmallVector<std::uint32_t, 4> v(resource, {1, 2, 3});
+    const std::uint32_t more[]{4, 5, 6, 7, 8, 9, 10};
+    REQUIRE(v.append(more));                // grows once, to exactly what's needed
+    REQUIRE(resource.allocations == 1);
+    REQUIRE(v.capacity() == 10);
+    REQUIRE(v.data() >= reinterpret_cast<std::uint32_t *>(arenaBuffer));
+    REQUIRE(v.data() < reinterpret_cast<std::uint32_t *>(arenaBuffer + sizeof(arenaBuffer)));
+    REQUIRE(v.sum() == 55);
+
+    REQUIRE(v.append(std::span<const std::uint32_t>(v.data(), v.size())));     // its own elements
+    REQUIRE(v.size() == 20);
+    REQUIRE(v[19] == 10);
+
+    REQUIRE_THROWS_AS(v.reserve(4096), std::bad_alloc);     // the arena is exhausted
+    REQUIRE(v.size() == 20);
+}
+
+TEST_CASE("SmallVector positional operations grow") {
+    SmallVector<std::string, 2> v{"b", "d"};
+    REQUIRE(v.insert(v.begin(), "a"));
+    REQUIRE(v.insert(v.begin() + 2, std::string("c")));
+    REQUIRE(v.emplace_back(v.front()));     // an element, while growing
+    const std::string expected[]{"a", "b", "c", "d", "a"};
+    REQUIRE(std::equal(v.begin(), v.end(), std::begin(expected), std::end(expected)));
+
+    //A bad position throws before the vector grows.
+    SmallVector<std::string, 2> full{"x", "y"};
+    const std::string more[]{"z"};
+    REQUIRE_THROWS_AS(full.insert(full.end() + 1, "z"), std::out_of_range);
+    REQUIRE_THROWS_AS(full.insert(full.end() + 1, more), std::out_of_range);
+    REQUIRE(full.isInline());
+
+    REQUIRE(v.resize(9, v[3]));
+    REQUIRE(v.back() == "d");
+    REQUIRE(v.resize(1));
+    REQUIRE(v.front() == "a");
+    REQUIRE(v.erase(v.begin(), v.end()) == v.end());
+    REQUIRE(v.empty());
+}
+
+TEST_CASE("SmallVector copies and moves") {
+    CountingResource resource(*std::pmr::new_delete_resource());
+    SmallVector<std::unique_ptr<int>, 2> spilled(resource);
+    for(int i = 0; i < 3; i++) {
+        REQUIRE(spilled.push_back(std::make_unique<int>(i)));
+    }
+    const auto *buffer = spilled.data();
+
+    SmallVector<std::unique_ptr<int>, 2> moved(std::move(spilled));
+    REQUIRE(moved.data() == buffer);        // took over the buffer
+    REQUIRE(&moved.resource() == &resource);
+    REQUIRE(spilled.empty());               // NOLINT(bugprone-use-after-move)
+    REQUIRE(spilled.isInline());
+
+    SmallVector<std::unique_ptr<int>, 2> inlined;
+    REQUIRE(inlined.push_back(std::make_unique<int>(7)));
+    moved = std::move(inlined);
+    REQUIRE(moved.isInline());
+    REQUIRE(*moved.front() == 7);
+    REQUIRE(resource.deallocations == resource.allocations);
+
+    SmallVector<std::string, 2> strings(resource, {"x", "y", "z"});
+    SmallVector<std::string, 2> copy(strings);
+    REQUIRE(&copy.resource() == &resource);
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy[2] == "z");
+    copy = SmallVector<std::string, 2>{"p"};
+    REQUIRE(copy.size() == 1);
+    REQUIRE(&copy.resource() == &resource);
+}
+
+TEST_CASE("SmallVector is a Vector of its current capacity") {
+    SmallVector<int, 2> small{1, 2};
+    Vector<int> &base = small;
+    REQUIRE_FALSE(base.push_back(3));
+    REQUIRE(small.push_back(3));
+    REQUIRE(base.size() == 3);
+    REQUIRE(base.capacity() == 4);
+    REQUIRE(sizeof(SmallVector<int, 8>) < sizeof(int) * 8 + 48);
+}
@@ -0,0 +1,67 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/StaticLatest.h"
+#include "doctest.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Pose {
+        double x, y, z;
+        std::uint64_t stamp;
+    };
+}
+
+TEST_CASE("StaticLatest holds the last stored value") {
+    StaticLatest<Pose> latest(Pose{1, 2, 3, 0});
+    REQUIRE(latest.version() == 0);
+    REQUIRE(latest.load().x == 1);
+
+    latest.store(Pose{4, 5, 6, 1});
+    latest.store(Pose{7, 8, 9, 2});
+    Pose pose{};
+    REQUIRE(latest.load(pose) == 2);
+    REQUIRE(pose.z == 9);
+    REQUIRE(pose.stamp == 2);
+    REQUIRE(latest.version() == 2);
+}
+
+TEST_CASE("StaticLatest readers never see a torn value") {
+    constexpr std::uint64_t count = 500000;
+    StaticLatest<Pose> latest;
+    std::atomic_bool done{false};
+    std::atomic_bool consistent{true};
+
+    std::vector<std::thread> readers;
+    for(int r = 0; r < 2; r++) {
+        readers.emplace_back([&]() {
+            std::uint64_t last = 0;
+            while(!done.load(std::memory_order_acquire)) {
+                Pose pose;
+                const auto version = latest.load(pose);
+                const auto stamp = pose.stamp;
+                if(version != stamp || stamp < last || pose.x != double(stamp) || pose.y != -double(stamp) ||
+                   pose.z != 2.0 * double(stamp)) {
+                    consistent.store(false, std::memory_order_relaxed);
+                }
+                last = stamp;
+            }
+        });
+    }
+
+    for(std::uint64_t i = 1; i <= count; i++) {
+        latest.store(Pose{double(i), -double(i), 2.0 * double(i), i});
+    }
+    done.store(true, std::memory_order_release);
+    for(auto &reader: readers) {
+        reader.join();
+    }
+
+    REQUIRE(consistent.load());
+    REQUIRE(latest.load().stamp == count);
+}
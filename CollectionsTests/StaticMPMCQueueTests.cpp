@@ -0,0 +1,173 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/StaticMPMCQueue.h"
+#include "../Collections/CircularQueue.h"
+#include "doctest.h"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("StaticMPMCQueue is created") {
+    StaticMPMCQueue<int, 4> queue;
+    REQUIRE(queue.empty());
+    REQUIRE(queue.capacity() == 4);
+    REQUIRE(queue.size() == 0); // NOLINT(readability-container-size-empty)
+    REQUIRE_FALSE(queue.full());
+
+    StaticMPMCQueue<int, 4> initialized = {4, 3, 2, 1};
+    REQUIRE(initialized.full());
+    REQUIRE_THROWS_AS((StaticMPMCQueue<int, 4>{5, 4, 3, 2, 1}), std::runtime_error);
+}
+
+TEST_CASE("StaticMPMCQueue single pushes and pops") {
+    StaticMPMCQueue<int, 4> queue;
+    Queue<int> base = queue;
+    for(int round = 0; round < 3; round++) {
+        for(int i = 1; i <= 4; i++) {
+            REQUIRE(base.push(i));
+            REQUIRE(base.size() == (size_t)i);
+        }
+        REQUIRE_FALSE(base.push(5));
+        REQUIRE(base.full());
+
+        int value;
+        REQUIRE(base.peek(value));
+        REQUIRE(value == 1);
+        for(int i = 1; i <= 4; i++) {
+            REQUIRE(base.pop(value));
+            REQUIRE(value == i);
+        }
+        REQUIRE_FALSE(base.pop(value));
+        REQUIRE_FALSE(base.peek(value));
+        REQUIRE(base.empty());
+    }
+}
+
+TEST_CASE("StaticMPMCQueue bulk push and pop") {
+    StaticMPMCQueue<int, 8> queue;
+    const int items[]{1, 2, 3, 4, 5, 6};
+    REQUIRE_FALSE(queue.push(nullptr, 1));
+    REQUIRE(queue.push(items, 6));
+    REQUIRE_FALSE(queue.push(items, 3));
+    REQUIRE(queue.size() == 6);
+
+    int out[8]{};
+    REQUIRE_FALSE(queue.pop(out, 7));
+    REQUIRE(queue.pop(out, 4));
+    REQUIRE(memcmp(out, items, 4 * sizeof(int)) == 0);
+
+    REQUIRE(queue.push(items, 6));
+    REQUIRE(queue.full());
+    REQUIRE(queue.popElements(3));
+    REQUIRE(queue.pop(out, 5));
+    const int expected[]{2, 3, 4, 5, 6};
+    REQUIRE(memcmp(out, expected, sizeof(expected)) == 0);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("StaticMPMCQueue moves elements") {
+    StaticMPMCQueue<std::string, 4> queue;
+    std::string item(100, 'x');
+    REQUIRE(queue.push(std::move(item)));
+    std::string out;
+    REQUIRE(queue.pop(out));
+    REQUIRE(out == std::string(100, 'x'));
+}
+
+namespace {
+    template<size_t SIZE>
+    class MutexCircularQueue {
+    public:
+        bool push(const uint64_t &item) { std::lock_guard<std::mutex> lock(mMutex); return mQueue.push(item); }
+        bool pop(uint64_t &item) { std::lock_guard<std::mutex> lock(mMutex); return mQueue.pop(item); }
+
+    private:
+        std::mutex mMutex;
+        CircularQueue<uint64_t, SIZE> mQueue;
+    };
+
+    // Each producer pushes perProducer values tagged with its id in the top bits.  Every consumer records what it
+    // received, and afterwards each value of each producer must have been received exactly once and, per consumer,
+    // in the order the producer pushed them.  Returns millions of elements per second.
+    template<typename QUEUE>
+    double stress(QUEUE &queue, size_t producers, size_t consumers, uint64_t perProducer, bool &valid) {
+        std::vector<std::vector<uint64_t>> received(consumers);
+        std::atomic<uint64_t> remaining{perProducer * producers};
+        std::vector<std::thread> threads;
+
+        const auto start = std::chrono::steady_clock::now();
+        for(size_t p = 0; p < producers; p++) {
+            threads.emplace_back([&queue, p, perProducer]() {
+                for(uint64_t i = 0; i < perProducer; i++) {
+                    while(!queue.push((p << 48) | i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for(size_t c = 0; c < consumers; c++) {
+            threads.emplace_back([&queue, &remaining, &out = received[c]]() {
+                uint64_t value;
+                while(remaining.load(std::memory_order_relaxed) > 0) {
+                    if(queue.pop(value)) {
+                        out.push_back(value);
+                        remaining.fetch_sub(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for(auto &thread: threads) {
+            thread.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        valid = true;
+        std::vector<std::vector<bool>> seen(producers, std::vector<bool>(perProducer, false));
+        for(const auto &values: received) {
+            std::vector<int64_t> last(producers, -1);
+            for(const auto value: values) {
+                const auto p = value >> 48;
+                const auto i = (int64_t)(value & 0xFFFFFFFFFFFF);
+                valid = valid && p < producers && i < (int64_t)perProducer && !seen[p][i] && i > last[p];
+                if(!valid) {
+                    return 0;
+                }
+                seen[p][i] = true;
+                last[p] = i;
+            }
+        }
+        for(const auto &producerSeen: seen) {
+            valid = valid && std::all_of(producerSeen.begin(), producerSeen.end(), [](bool b) { return b; });
+        }
+        return (double)(perProducer * producers) / elapsed.count() / 1e6;
+    }
+}
+
+TEST_CASE("StaticMPMCQueue multi thread stress and throughput") {
+    constexpr uint64_t TOTAL_ELEMENTS = 400'000;
+    const size_t maxThreads = std::max<size_t>(4, std::thread::hardware_concurrency());
+
+    for(size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        bool valid = false;
+        auto queue = std::make_unique<StaticMPMCQueue<uint64_t, 1024>>();
+        const double lockFreeRate = stress(*queue, threads, threads, TOTAL_ELEMENTS / threads, valid);
+        REQUIRE(valid);
+        REQUIRE(queue->empty());
+
+        auto locked = std::make_unique<MutexCircularQueue<1024>>();
+        const double mutexRate = stress(*locked, threads, threads, TOTAL_ELEMENTS / threads, valid);
+        REQUIRE(valid);
+
+        MESSAGE(threads << " producers/" << threads << " consumers: StaticMPMCQueue " << lockFreeRate
+                << " M elements/s, mutex + CircularQueue " << mutexRate << " M elements/s");
+    }
+}
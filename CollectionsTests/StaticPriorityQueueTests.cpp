@@ -0,0 +1,181 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/StaticPriorityQueue.h"
+#include "doctest.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+TEST_CASE("StaticPriorityQueue pops the largest element first") {
+    StaticPriorityQueue<int, 16> queue = {5, 1, 9, 3, 7};
+    REQUIRE(queue.size() == 5);
+    REQUIRE(queue.capacity() == 16);
+    REQUIRE(queue.top() == 9);
+
+    int value;
+    REQUIRE(queue.peek(value));
+    REQUIRE(value == 9);
+    for(int expected: {9, 7, 5, 3, 1}) {
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == expected);
+    }
+    REQUIRE_FALSE(queue.pop(value));
+    REQUIRE_FALSE(queue.peek(value));
+    REQUIRE(queue.empty());
+    REQUIRE_THROWS_AS(queue.top(), std::underflow_error);
+}
+
+TEST_CASE("StaticPriorityQueue with std::greater pops the smallest element first") {
+    StaticPriorityQueue<int, 8, std::greater<int>> queue;
+    for(int i: {4, 8, 2, 6}) {
+        REQUIRE(queue.push(i));
+    }
+    int out[4];
+    REQUIRE(queue.pop(out, 4));
+    const int expected[]{2, 4, 6, 8};
+    REQUIRE(std::equal(std::begin(out), std::end(out), std::begin(expected)));
+}
+
+TEST_CASE("StaticPriorityQueue respects its capacity") {
+    StaticPriorityQueue<int, 4> queue;
+    const int items[]{1, 2, 3, 4, 5};
+    REQUIRE_FALSE(queue.push(items, 5));
+    REQUIRE(queue.empty());
+    REQUIRE(queue.push(items, 4));
+    REQUIRE(queue.full());
+    REQUIRE_FALSE(queue.push(5));
+
+    int out[5];
+    REQUIRE_FALSE(queue.pop(out, 5));
+    REQUIRE(queue.size() == 4);
+    REQUIRE(queue.popElements(2));
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.top() == 2);
+
+    queue.clear();
+    REQUIRE(queue.empty());
+    REQUIRE(queue.push(items, 4));
+
+    using Q = StaticPriorityQueue<int, 2>;
+    REQUIRE_THROWS_AS(Q({1, 2, 3}), std::runtime_error);
+}
+
+TEST_CASE("StaticPriorityQueue bulk push matches a reference heap") {
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> values(-1000, 1000);
+    StaticPriorityQueue<int, 512> queue;
+    std::vector<int> reference;
+
+    // Small batches onto a large queue sift up, large batches onto a small queue rebuild the heap.
+    for(size_t batch: {100, 3, 1, 150, 20, 200}) {
+        std::vector<int> items(batch);
+        std::generate(items.begin(), items.end(), [&]() { return values(random); });
+        REQUIRE(queue.push(items.data(), items.size()));
+        reference.insert(reference.end(), items.begin(), items.end());
+
+        std::sort(reference.begin(), reference.end(), std::greater<>());
+        const size_t popCount = reference.size() / 3;
+        std::vector<int> out(popCount);
+        REQUIRE(queue.pop(out.data(), popCount));
+        REQUIRE(std::equal(out.begin(), out.end(), reference.begin()));
+        reference.erase(reference.begin(), reference.begin() + (long)popCount);
+        REQUIRE(queue.size() == reference.size());
+    }
+}
+
+TEST_CASE("StaticPriorityQueue handles follow their elements") {
+    StaticPriorityQueue<int, 32, std::greater<int>> queue;
+    using Handle = decltype(queue)::Handle;
+    Handle handles[20];
+    for(int i = 0; i < 20; i++) {
+        REQUIRE(queue.push(100 + i, handles[i]));
+    }
+    for(int i = 0; i < 20; i++) {
+        REQUIRE(queue.contains(handles[i]));
+        REQUIRE(queue.get(handles[i]) == 100 + i);
+    }
+
+    // decrease-key moves an element to the front, increasing a key moves it back
+    queue.updateKey(handles[15], 1);
+    REQUIRE(queue.top() == 1);
+    queue.updateKey(handles[0], 500);
+    REQUIRE(queue.get(handles[0]) == 500);
+    REQUIRE(queue.get(handles[15]) == 1);
+
+    REQUIRE(queue.erase(handles[7]));
+    REQUIRE_FALSE(queue.contains(handles[7]));
+    REQUIRE_FALSE(queue.erase(handles[7]));
+    REQUIRE_THROWS_AS(queue.updateKey(handles[7], 3), std::invalid_argument);
+    REQUIRE(queue.size() == 19);
+
+    int value;
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 1);
+    REQUIRE_FALSE(queue.contains(handles[15]));
+
+    // A popped handle's slot gets reused, but the stale handle doesn't alias the new element.
+    Handle reused;
+    REQUIRE(queue.push(42, reused));
+    REQUIRE(queue.contains(reused));
+    REQUIRE_FALSE(queue.contains(handles[15]));
+    REQUIRE_FALSE(queue.contains(handles[7]));
+    REQUIRE_FALSE(queue.contains(Handle{}));
+
+    std::vector<int> expected;
+    for(int i = 1; i < 20; i++) {
+        if(i != 7 && i != 15) {
+            expected.push_back(100 + i);
+        }
+    }
+    expected.push_back(42);
+    expected.push_back(500);
+    std::sort(expected.begin(), expected.end());
+    for(int e: expected) {
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == e);
+    }
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("StaticPriorityQueue random updates keep the heap ordered") {
+    std::mt19937 random(99);
+    std::uniform_int_distribution<int> values(0, 10000);
+    StaticPriorityQueue<int, 256> queue;
+    using Handle = decltype(queue)::Handle;
+    std::vector<std::pair<Handle, int>> live;
+
+    for(int round = 0; round < 2000; round++) {
+        const int op = (int)(random() % 4);
+        if(op == 0 && !queue.full()) {
+            Handle handle;
+            const int value = values(random);
+            REQUIRE(queue.push(value, handle));
+            live.emplace_back(handle, value);
+        } else if(op == 1 && !live.empty()) {
+            auto &[handle, value] = live[random() % live.size()];
+            value = values(random);
+            queue.updateKey(handle, value);
+        } else if(op == 2 && !live.empty()) {
+            const size_t pick = random() % live.size();
+            REQUIRE(queue.erase(live[pick].first));
+            live.erase(live.begin() + (long)pick);
+        } else if(!live.empty()) {
+            auto best = std::max_element(live.begin(), live.end(),
+                                         [](const auto &a, const auto &b) { return a.second < b.second; });
+            int value;
+            REQUIRE(queue.pop(value));
+            REQUIRE(value == best->second);
+            // Equal values may come out in either order, so drop any live entry with that value whose handle died.
+            auto popped = std::find_if(live.begin(), live.end(), [&](const auto &entry) {
+                return entry.second == value && !queue.contains(entry.first);
+            });
+            REQUIRE(popped != live.end());
+            live.erase(popped);
+        }
+        REQUIRE(queue.size() == live.size());
+    }
+}
@@ -0,0 +1,160 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/StaticSoAVector.h"
+#include "../Collections/StaticVector.h"
+#include "doctest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+
+TEST_CASE("StaticSoAVector rows") {
+    StaticSoAVector<4, int, float, char> v{{1, 1.5f, 'a'}};
+    REQUIRE(v.capacity() == 4);
+    REQUIRE(v.push_back({2, 2.5f, 'b'}));
+    REQUIRE(v.emplace_back(3, 3.5f, 'c'));
+    REQUIRE(v.size() == 3);
+    REQUIRE(std::get<1>(v[1]) == 2.5f);
+    REQUIRE(std::get<2>(v.back()) == 'c');
+    REQUIRE_THROWS_AS(v[3], std::out_of_range);
+
+    auto [number, weight, letter] = v[0];     // references into the columns
+    number = 10;
+    letter = 'z';
+    REQUIRE(v.column<0>()[0] == 10);
+    REQUIRE(v.column<2>()[0] == 'z');
+    (void)weight;
+
+    v[2] = std::tuple{30, 30.5f, 'x'};
+    v.front() = v[2];                           // assigns values, the proxy doesn't rebind
+    const std::tuple<int, float, char> row = v[0];
+    REQUIRE(row == std::tuple{30, 30.5f, 'x'});
+
+    REQUIRE(v.push_back({4, 4.5f, 'd'}));
+    REQUIRE(v.full());
+    REQUIRE_FALSE(v.emplace_back(5, 5.5f, 'e'));
+    v.pop_back();
+    REQUIRE(v.size() == 3);
+    v.clear();
+    REQUIRE(v.empty());
+    REQUIRE_THROWS_AS(v.front(), std::range_error);
+}
+
+TEST_CASE("StaticSoAVector columns are contiguous and aligned") {
+    StaticSoAVector<100, double, std::uint8_t, float> v;
+    for(int i = 0; i < 100; i++) {
+        REQUIRE(v.emplace_back(i, static_cast<std::uint8_t>(i), 2.0f * static_cast<float>(i)));
+    }
+    const auto &constV = v;
+    std::span<const float> floats = constV.column<2>();
+    REQUIRE(floats.size() == 100);
+    REQUIRE(std::accumulate(floats.begin(), floats.end(), 0.0f) == 9900.0f);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(v.column<0>().data()) % CACHE_LINE_SIZE == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(v.column<1>().data()) % CACHE_LINE_SIZE == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(floats.data()) % CACHE_LINE_SIZE == 0);
+
+    std::span<std::uint8_t> bytes = v.column<1>();
+    std::fill(bytes.begin(), bytes.end(), 7);
+    REQUIRE(std::get<1>(v[99]) == 7);
+}
+
+TEST_CASE("StaticSoAVector iterators") {
+    StaticSoAVector<8, int, int> v{{1, 10}, {2, 20}, {3, 30}};
+    int total = 0;
+    for(auto [a, b]: v) {
+        b += a;
+        total += b;
+    }
+    REQUIRE(total == 66);
+    REQUIRE(v.end() - v.begin() == 3);
+
+    REQUIRE(std::count_if(v.begin(), v.end(), [](const auto &r) { return std::get<1>(r) > 20; }) == 2);
+    std::transform(v.begin() + 1, v.end(), v.begin(), v.begin(), [](const auto &next, const auto &r) {
+        return std::tuple{std::get<0>(r), std::get<1>(next)};
+    });
+    REQUIRE(std::get<1>(v[0]) == 22);
+    REQUIRE(std::get<1>(v[1]) == 33);
+
+    const auto &constV = v;
+    StaticSoAVector<8, int, int>::const_iterator it = v.begin();
+    REQUIRE(it == constV.begin());
+    REQUIRE(std::get<1>(it[1]) == 33);
+    REQUIRE(std::find_if(constV.begin(), constV.end(), [](const auto &r) { return std::get<0>(r) == 3; }) ==
+            constV.begin() + 2);
+}
+
+TEST_CASE("StaticSoAVector constructs only the rows in use") {
+    StaticSoAVector<1024, std::string, std::unique_ptr<int>> v;
+    REQUIRE(v.emplace_back("one", std::make_unique<int>(1)));
+    REQUIRE(v.push_back({"two", std::make_unique<int>(2)}));
+    REQUIRE(*std::get<1>(v[1]) == 2);
+
+    StaticSoAVector<1024, std::string, std::unique_ptr<int>> moved(std::move(v));
+    REQUIRE(v.empty());         // NOLINT(bugprone-use-after-move)
+    REQUIRE(std::get<0>(moved.front()) == "one");
+    v = std::move(moved);
+    REQUIRE(v.size() == 2);
+
+    StaticSoAVector<4, std::string, int> strings{{"a", 1}, {"b", 2}};
+    StaticSoAVector<4, std::string, int> copy(strings);
+    strings.clear();
+    REQUIRE(std::get<0>(copy[1]) == "b");
+    StaticSoAVector<4, int, double> numbers{{1, 1.0}, {2, 2.0}};
+    StaticSoAVector<4, int, double> numbersCopy;
+    numbersCopy = numbers;
+    REQUIRE(std::get<1>(numbersCopy.back()) == 2.0);
+}
+
+namespace {
+    struct Particle {
+        float x, y, z;
+        float vx, vy, vz;
+        float mass;
+        std::uint32_t id;
+    };
+}
+
+TEST_CASE("StaticSoAVector column scan compared with an array of structures") {
+    constexpr size_t size = 16384;
+    constexpr int iterations = 200;
+    static StaticVector<Particle, size> particles;
+    static StaticSoAVector<size, float, float, float, float, float, float, float, std::uint32_t> columns;
+    for(size_t i = 0; i < size; i++) {
+        const auto f = static_cast<float>(i % 7);
+        REQUIRE(particles.push_back({f, f, f, f, f, f, f, static_cast<std::uint32_t>(i)}));
+        REQUIRE(columns.emplace_back(f, f, f, f, f, f, f, static_cast<std::uint32_t>(i)));
+    }
+
+    float sink = 0;
+    const auto time = [&](auto update) {
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iterations; i++) {
+            update();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    };
+    const double arrayOfStructures = time([&] {
+        for(auto &particle: particles) {
+            particle.x += particle.vx;
+        }
+        sink += particles[static_cast<int>(size) - 1].x;
+    });
+    const double structureOfArrays = time([&] {
+        auto x = columns.column<0>();
+        auto vx = columns.column<3>();
+        for(size_t i = 0; i < x.size(); i++) {
+            x[i] += vx[i];
+        }
+        sink += x.back();
+    });
+    REQUIRE(particles.back().x == columns.column<0>().back());
+    REQUIRE(sink > 0);
+    MESSAGE("ns per x += vx over 16384 particles: StaticVector<Particle> " << arrayOfStructures
+            << ", StaticSoAVector " << structureOfArrays);
+}
@@ -0,0 +1,77 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/StaticTripleBuffer.h"
+#include "doctest.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+TEST_CASE("StaticTripleBuffer reader sees the newest value") {
+    StaticTripleBuffer<std::string> buffer("initial");
+    REQUIRE(buffer.current() == "initial");
+    REQUIRE_FALSE(buffer.update());
+
+    buffer.write("first");
+    buffer.write("second");
+    REQUIRE(buffer.current() == "initial");     // nothing taken yet
+    REQUIRE(buffer.read() == "second");         // "first" was replaced before the reader got to it
+    REQUIRE_FALSE(buffer.update());
+    REQUIRE(buffer.current() == "second");
+
+    for(int i = 0; i < 10; i++) {
+        auto &next = buffer.writeBuffer();
+        next = "value " + std::to_string(i);
+        buffer.publish();
+        REQUIRE(buffer.update());
+        REQUIRE(buffer.current() == next);
+    }
+}
+
+TEST_CASE("StaticTripleBuffer values stay complete and in order across threads") {
+    struct Sample {
+        std::uint64_t sequence;
+        std::uint64_t payload[7];
+    };
+    constexpr std::uint64_t count = 500000;
+    StaticTripleBuffer<Sample> buffer;
+    std::atomic_bool done{false};
+
+    std::thread writer([&]() {
+        for(std::uint64_t i = 1; i <= count; i++) {
+            Sample &sample = buffer.writeBuffer();
+            sample.sequence = i;
+            for(auto &word: sample.payload) {
+                word = i * 3;
+            }
+            buffer.publish();
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    std::uint64_t last = 0;
+    std::uint64_t updates = 0;
+    bool consistent = true;
+    while(last < count) {
+        const bool finished = done.load(std::memory_order_acquire);
+        if(buffer.update()) {
+            const Sample &sample = buffer.current();
+            consistent = consistent && sample.sequence > last;
+            for(auto word: sample.payload) {
+                consistent = consistent && word == sample.sequence * 3;
+            }
+            last = sample.sequence;
+            updates++;
+        } else if(finished) {
+            break;
+        }
+    }
+    writer.join();
+
+    REQUIRE(consistent);
+    REQUIRE(last == count);
+    MESSAGE("reader took " << updates << " of " << count << " values");
+}
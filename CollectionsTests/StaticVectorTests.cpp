@@ -6,6 +6,9 @@
 #include "doctest.h"
 
 #include <cstring>
+#include <algorithm>
+#include <memory>
+#include <string>
 
 //----------------------------------------------------------------------------
 // Snitch test cases:
@@ -38,4 +41,119 @@ TEST_CASE("StaticVector Construction") {
             REQUIRE(false);
         }
     }
-}
\ No newline at end of file
+}
+namespace {
+    // Counts live instances; no default constructor.
+    struct Tracked {
+        static inline int live = 0;
+        static inline int copies = 0;
+        int value;
+
+        explicit Tracked(int v): value(v) { live++; }
+        Tracked(const Tracked &other): value(other.value) { live++; copies++; }
+        Tracked(Tracked &&other) noexcept: value(other.value) { live++; }
+        Tracked &operator=(const Tracked &) = default;
+        ~Tracked() { live--; }
+    };
+}
+
+TEST_CASE("StaticVector constructs only the elements in use") {
+    Tracked::live = 0;
+    {
+        StaticVector<Tracked, 1024> v;
+        REQUIRE(Tracked::live == 0);
+
+        REQUIRE(v.emplace_back(1));
+        const Tracked two(2);
+        REQUIRE(v.push_back(two));
+        REQUIRE(v.push_back(Tracked(3)));
+        REQUIRE(Tracked::live == 4);    // three in the vector plus two
+        REQUIRE(v.back().value == 3);
+
+        v.pop_back();
+        REQUIRE(Tracked::live == 3);
+        REQUIRE(v.size() == 2);
+        REQUIRE_THROWS_AS(v[2], std::out_of_range);
+
+        Tracked::copies = 0;
+        StaticVector<Tracked, 1024> copy(v);
+        REQUIRE(Tracked::copies == 2);
+        REQUIRE(Tracked::live == 5);
+        REQUIRE(copy[1].value == 2);
+
+        StaticVector<Tracked, 1024> moved(std::move(copy));
+        REQUIRE(copy.empty());  // NOLINT(bugprone-use-after-move)
+        REQUIRE(moved.size() == 2);
+        REQUIRE(Tracked::live == 5);
+
+        moved = v;
+        REQUIRE(Tracked::live == 5);
+        v.clear();
+        REQUIRE(Tracked::live == 3);
+        v = std::move(moved);
+        REQUIRE(v.size() == 2);
+        REQUIRE(Tracked::live == 3);
+    }
+    REQUIRE(Tracked::live == 0);
+}
+
+TEST_CASE("StaticVector holds move-only elements") {
+    StaticVector<std::unique_ptr<int>, 4> v;
+    REQUIRE(v.push_back(std::make_unique<int>(1)));
+    REQUIRE(v.emplace_back(new int(2)));
+    REQUIRE(*v[1] == 2);
+
+    StaticVector<std::unique_ptr<int>, 4> moved(std::move(v));
+    REQUIRE(*moved.front() == 1);
+    REQUIRE(v.empty());     // NOLINT(bugprone-use-after-move)
+}
+
+TEST_CASE("StaticVector inserts and erases elements that aren't trivially copyable") {
+    StaticVector<std::string, 8> v{"a", "d"};
+    const std::string middle[]{"b", "c"};
+    REQUIRE(v.insert(v.begin() + 1, middle));
+    REQUIRE(v.emplace(v.end(), 2, 'e'));
+    REQUIRE(v.insert(v.begin(), v[4]));
+    REQUIRE(v.insert(v.begin() + 1, std::string("f")));
+    const std::string expected[]{"ee", "f", "a", "b", "c", "d", "ee"};
+    REQUIRE(std::equal(v.begin(), v.end(), std::begin(expected), std::end(expected)));
+
+    REQUIRE(*v.erase(v.begin()) == "f");
+    REQUIRE(*v.erase(v.begin() + 1, v.begin() + 3) == "c");
+    REQUIRE(v.append(middle));
+    const std::string erased[]{"f", "c", "d", "ee", "b", "c"};
+    REQUIRE(std::equal(v.begin(), v.end(), std::begin(erased), std::end(erased)));
+
+    REQUIRE(v.resize(8, "g"));
+    REQUIRE(v.back() == "g");
+    REQUIRE(v.resize(1));
+    REQUIRE(v.front() == "f");
+}
+
+TEST_CASE("StaticVector insert and erase keep every element constructed once") {
+    Tracked::live = 0;
+    {
+        StaticVector<Tracked, 8> v;
+        for(int i = 0; i < 4; i++) {
+            REQUIRE(v.emplace_back(i));
+        }
+        const Tracked extra[]{Tracked(10), Tracked(11), Tracked(12), Tracked(13)};
+        REQUIRE(v.insert(v.begin() + 3, std::span<const Tracked>(extra, 3)));   // fewer than the tail
+        REQUIRE(v.insert(v.begin() + 1, Tracked(20)));
+        REQUIRE(Tracked::live == 12);
+        REQUIRE_FALSE(v.insert(v.begin(), std::span<const Tracked>(extra, 1)));
+
+        v.erase(v.begin() + 2, v.begin() + 6);
+        REQUIRE(v.size() == 4);
+        REQUIRE(Tracked::live == 8);
+        REQUIRE(v.insert(v.begin() + 3, extra));   // more than the tail
+        REQUIRE(Tracked::live == 12);
+        const int expected[]{0, 20, 12, 10, 11, 12, 13, 3};
+        for(int i = 0; i < 8; i++) {
+            REQUIRE(v[i].value == expected[i]);
+        }
+        REQUIRE(v.resize(2, extra[0]));
+        REQUIRE(Tracked::live == 6);
+    }
+    REQUIRE(Tracked::live == 0);
+}
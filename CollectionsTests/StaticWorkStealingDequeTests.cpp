@@ -0,0 +1,117 @@
+//
+// Created by Craig Home on 10/16/26.
+//
+
+#include "../Collections/StaticWorkStealingDeque.h"
+#include "doctest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("StaticWorkStealingDeque owner pops LIFO and thieves steal FIFO") {
+    StaticWorkStealingDeque<int, 8> deque;
+    REQUIRE(deque.empty());
+    REQUIRE(deque.capacity() == 8);
+
+    for(int i = 1; i <= 5; i++) {
+        REQUIRE(deque.push(i));
+    }
+    REQUIRE(deque.size() == 5);
+
+    int value;
+    REQUIRE(deque.pop(value));
+    REQUIRE(value == 5);
+    REQUIRE(deque.steal(value));
+    REQUIRE(value == 1);
+    REQUIRE(deque.steal() == 2);
+    REQUIRE(deque.pop() == 4);
+    REQUIRE(deque.pop() == 3);      // the last element goes through the CAS
+
+    REQUIRE(deque.empty());
+    REQUIRE_FALSE(deque.pop(value));
+    REQUIRE_FALSE(deque.steal(value));
+    REQUIRE_FALSE(deque.pop().has_value());
+    REQUIRE(deque.size() == 0);     // NOLINT(readability-container-size-empty)
+}
+
+TEST_CASE("StaticWorkStealingDeque respects its capacity") {
+    StaticWorkStealingDeque<int, 4> deque;
+    for(int round = 0; round < 3; round++) {
+        for(int i = 0; i < 4; i++) {
+            REQUIRE(deque.push(i));
+        }
+        REQUIRE_FALSE(deque.push(4));
+        REQUIRE(deque.size() == 4);
+
+        // stealing frees room at the top, so the indices keep moving through the ring
+        REQUIRE(deque.steal() == 0);
+        REQUIRE(deque.push(4));
+        REQUIRE(deque.pop() == 4);
+        REQUIRE(deque.steal() == 1);
+        REQUIRE(deque.pop() == 3);
+        REQUIRE(deque.pop() == 2);
+        REQUIRE(deque.empty());
+    }
+}
+
+TEST_CASE("StaticWorkStealingDeque hands every element out exactly once under heavy stealing") {
+    constexpr int count = 500000;
+    constexpr int thieves = 4;
+    StaticWorkStealingDeque<int, 256> deque;
+    auto taken = std::make_unique<std::atomic_int[]>(count);
+    std::atomic_int total{0};
+    std::atomic_bool done{false};
+
+    auto take = [&](int value) {
+        taken[value].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < thieves; t++) {
+        threads.emplace_back([&]() {
+            while(!done.load(std::memory_order_acquire)) {
+                int value;
+                if(deque.steal(value)) {
+                    take(value);
+                }
+            }
+        });
+    }
+
+    // The owner pushes in bursts and pops only now and then, so most elements are stolen and the owner's pops keep
+    // meeting thieves at the last element.
+    int value;
+    for(int next = 0; next < count;) {
+        for(int burst = 0; burst < 8 && next < count; burst++) {
+            if(deque.push(next)) {
+                next++;
+            } else if(deque.pop(value)) {
+                take(value);
+            }
+        }
+        if(next % 3 == 0 && deque.pop(value)) {
+            take(value);
+        }
+    }
+    while(deque.pop(value)) {
+        take(value);
+    }
+    while(total.load(std::memory_order_relaxed) < count) {
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    for(auto &thread: threads) {
+        thread.join();
+    }
+
+    REQUIRE(total.load() == count);
+    bool exactlyOnce = true;
+    for(int i = 0; i < count; i++) {
+        exactlyOnce = exactlyOnce && taken[i].load() == 1;
+    }
+    REQUIRE(exactlyOnce);
+    REQUIRE(deque.empty());
+}
@@ -5,8 +5,13 @@
 #include "../Collections/Vector.h"
 #include "doctest.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <numeric>
+#include <random>
+#include <string>
 
 TEST_CASE("Vector Construction") {
 
@@ -25,6 +30,25 @@ TEST_CASE("Vector Construction") {
     }
 }
 
+TEST_CASE("Vector over uninitialized storage") {
+    //An array of live strings would be overwritten without being destroyed, so only the tagged constructor takes
+    //storage for a T that isn't trivial.
+    static_assert(!std::is_constructible_v<Vector<std::string>, std::string *, size_t>);
+    static_assert(std::is_constructible_v<Vector<int>, int *, size_t>);
+
+    alignas(std::string) std::byte storage[2 * sizeof(std::string)];
+    const auto *data = reinterpret_cast<std::string *>(storage);
+    REQUIRE_THROWS_AS(Vector<std::string>(uninitializedStorage, nullptr, 2), std::invalid_argument);
+    {
+        Vector<std::string> v(uninitializedStorage, reinterpret_cast<std::string *>(storage), 2);
+        REQUIRE(v.push_back("a string too long for the small string buffer"));
+        REQUIRE(v.emplace_back(3, 'x'));
+        REQUIRE_FALSE(v.push_back("full"));
+        REQUIRE(v.data() == data);
+        REQUIRE(v[1] == "xxx");
+    }   // destroys both strings
+}
+
 TEST_CASE("Vector push back") {
     int data[4];
     Vector<int> v{data, std::size(data)};
@@ -75,4 +99,172 @@ TEST_CASE("Vector iterators") {
     v.push_back(3);
     v.push_back(4);
     REQUIRE(std::accumulate(v.begin(), v.end(), 0) == 10);
-}
\ No newline at end of file
+}
+TEST_CASE("Vector insert and erase") {
+    int data[8];
+    Vector<int> v{data, std::size(data)};
+    const int initial[]{1, 2, 5};
+    REQUIRE(v.append(initial));
+
+    REQUIRE(v.insert(v.begin() + 2, 4));
+    REQUIRE(v.insert(v.begin() + 2, 3));
+    REQUIRE(v.insert(v.begin(), 0));
+    REQUIRE(v.insert(v.end(), 6));
+    const int inserted[]{0, 1, 2, 3, 4, 5, 6};
+    REQUIRE(v.size() == std::size(inserted));
+    REQUIRE(memcmp(inserted, v.data(), sizeof(inserted)) == 0);
+
+    REQUIRE(v.insert(v.begin(), v[6]));     // an element of the vector itself
+    REQUIRE(v.full());
+    REQUIRE(v.front() == 6);
+    REQUIRE_FALSE(v.insert(v.begin(), 7));
+    REQUIRE_THROWS_AS(v.erase(v.end()), std::out_of_range);
+
+    REQUIRE(*v.erase(v.begin()) == 0);
+    auto next = v.erase(v.begin() + 1, v.begin() + 4);
+    REQUIRE(*next == 4);
+    const int erased[]{0, 4, 5, 6};
+    REQUIRE(v.size() == std::size(erased));
+    REQUIRE(memcmp(erased, v.data(), sizeof(erased)) == 0);
+    REQUIRE(v.erase(v.begin() + 2, v.end()) == v.end());
+    REQUIRE(v.size() == 2);
+    REQUIRE_THROWS_AS(v.erase(v.begin() + 1, v.begin()), std::out_of_range);
+}
+
+TEST_CASE("Vector bulk insert, append and resize") {
+    int data[8];
+    Vector<int> v{data, std::size(data)};
+    const int ends[]{1, 6};
+    const int middle[]{2, 3, 4, 5};
+    REQUIRE(v.append(ends));
+    REQUIRE(v.insert(v.begin() + 1, middle));
+    const int expected[]{1, 2, 3, 4, 5, 6};
+    REQUIRE(memcmp(expected, v.data(), sizeof(expected)) == 0);
+
+    REQUIRE_FALSE(v.append(middle));        // all or nothing
+    REQUIRE_FALSE(v.insert(v.begin(), middle));
+    REQUIRE(v.size() == 6);
+    REQUIRE(v.append(std::span<const int>{}));
+
+    REQUIRE(v.resize(8, 9));
+    REQUIRE(v.back() == 9);
+    REQUIRE_FALSE(v.resize(9));
+    REQUIRE(v.resize(2));
+    REQUIRE(v.size() == 2);
+    REQUIRE(v.resize(3));
+    REQUIRE(v.back() == 0);
+}
+
+TEST_CASE("Vector appends a 4KB span at once") {
+    std::uint8_t data[8192];
+    Vector<std::uint8_t> v{data, std::size(data)};
+    std::uint8_t page[4096];
+    std::iota(std::begin(page), std::end(page), 0);
+    REQUIRE(v.append(page));
+    REQUIRE(v.append(page));
+    REQUIRE(v.full());
+    REQUIRE(memcmp(page, v.data() + 4096, sizeof(page)) == 0);
+    REQUIRE_FALSE(v.append(page));
+}
+
+TEST_CASE("Vector find, count, min, max and sum") {
+    std::uint32_t data[8]{};
+    Vector<std::uint32_t> v{data, std::size(data)};
+    REQUIRE(v.find(1) == v.end());
+    REQUIRE(v.sum() == 0);
+    REQUIRE_THROWS_AS((void)v.min(), std::range_error);
+    REQUIRE_THROWS_AS((void)v.max(), std::range_error);
+
+    const std::uint32_t values[]{7, 3, 0xFFFFFFFF, 3, 9};
+    REQUIRE(v.append(values));
+    REQUIRE(v.find(3) == v.begin() + 1);
+    REQUIRE(v.contains(9));
+    REQUIRE_FALSE(v.contains(4));
+    REQUIRE(v.count(3) == 2);
+    REQUIRE(v.min() == 3);
+    REQUIRE(v.max() == 0xFFFFFFFF);          // unsigned compare
+    REQUIRE(v.sum() == 22ull + 0xFFFFFFFF);  // no 32 bit wrap
+
+    *v.find(9) = 1;
+    REQUIRE(v.min() == 1);
+
+    alignas(std::string) std::byte strings[4 * sizeof(std::string)];
+    Vector<std::string> names{uninitializedStorage, reinterpret_cast<std::string *>(strings), 4};
+    REQUIRE(names.push_back("a"));
+    REQUIRE(names.push_back("b"));
+    REQUIRE(names.find("b") == names.begin() + 1);
+    REQUIRE(names.count("c") == 0);
+}
+
+namespace {
+    // Checks a scan implementation against the std algorithms for every length up to 100 and each position of the
+    // needle, so that each vector loop and the scalar tail get exercised.
+    template<typename SCAN, typename T>
+    void checkScan(std::mt19937 &random) {
+        std::uniform_int_distribution<int> values(-50, 50);
+        T data[100];
+        for(size_t size = 1; size <= std::size(data); size++) {
+            std::generate_n(data, size, [&] { return static_cast<T>(values(random)); });
+            for(size_t at = 0; at < size; at++) {
+                const T needle = data[at];
+                REQUIRE(SCAN::find(data, size, needle) == static_cast<size_t>(std::find(data, data + size, needle) - data));
+                REQUIRE(SCAN::count(data, size, needle) == static_cast<size_t>(std::count(data, data + size, needle)));
+            }
+            REQUIRE(SCAN::find(data, size, static_cast<T>(99)) == size);
+            REQUIRE(SCAN::template extreme<false>(data, size) == *std::min_element(data, data + size));
+            REQUIRE(SCAN::template extreme<true>(data, size) == *std::max_element(data, data + size));
+            REQUIRE(SCAN::sum(data, size) == std::accumulate(data, data + size, ScanSum<T>{}));
+        }
+    }
+
+    template<typename SCAN>
+    void checkScans() {
+        std::mt19937 random(1);
+        checkScan<SCAN, std::int32_t>(random);
+        checkScan<SCAN, std::uint32_t>(random);
+        checkScan<SCAN, float>(random);     // small integers, so every sum is exact
+    }
+}
+
+TEST_CASE("Vector scan kernels agree with the std algorithms") {
+    std::mt19937 random(2);
+    checkScan<VectorScan<std::int64_t>, std::int64_t>(random);    // plain loops
+    checkScan<VectorScan<double>, double>(random);
+    checkScan<VectorScan<float>, float>(random);
+#if defined(STATICCOLLECTIONS_SIMD_SCAN)
+    checkScans<Sse2Scan>();
+    if(SimdScanSupport::AVX2) {
+        checkScans<Avx2Scan>();
+    }
+#endif
+}
+
+TEST_CASE("Vector find compared with std::find") {
+    constexpr size_t size = 4096;
+    constexpr int iterations = 20000;
+    static std::uint32_t data[size];
+    Vector<std::uint32_t> v{data, size};
+    REQUIRE(v.resize(size));
+    std::iota(v.begin(), v.end(), 0u);
+    const std::uint32_t needle = size - 1;       // the worst case, a full scan
+
+    size_t found = 0;
+    const auto time = [&](auto find) {
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iterations; i++) {
+            found += find(needle + (i & 1));    // alternates hit and miss so the loop can't be hoisted
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    };
+    const double stdFind = time([&](std::uint32_t x) { return std::find(v.begin(), v.end(), x) - v.begin(); });
+    const double vectorFind = time([&](std::uint32_t x) { return v.find(x) - v.begin(); });
+    REQUIRE(found == iterations * (2 * size - 1));
+#if defined(STATICCOLLECTIONS_SIMD_SCAN)
+    const char *kernel = SimdScanSupport::AVX2 ? "AVX2" : "SSE2";
+#else
+    const char *kernel = "scalar";
+#endif
+    MESSAGE("ns per 4096 element uint32_t scan: std::find " << stdFind << ", Vector::find (" << kernel << ") "
+            << vectorFind);
+}